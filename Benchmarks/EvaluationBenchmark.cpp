@@ -0,0 +1,209 @@
+#include "../Calculator/BaseOperations/BaseOperation.h"
+#include "../Calculator/JIT/JIT.h"
+#include <chrono>
+#include <iostream>
+
+/**
+* @brief number of evaluations of every expression by every way
+*/
+constexpr size_t EVALUATIONS = 200000;
+
+/**
+* @brief addition function of baseline, result is allocated in the literal container
+*/
+std::shared_ptr<Literal> BaselineAdd(std::shared_ptr<Operand> a, std::shared_ptr<Operand> b) {
+  return std::make_shared<Literal>(a->GetValue() + b->GetValue());
+}
+
+/**
+* @brief subtraction function of baseline, result is allocated in the literal container
+*/
+std::shared_ptr<Literal> BaselineSub(std::shared_ptr<Operand> a, std::shared_ptr<Operand> b) {
+  return std::make_shared<Literal>(a->GetValue() - b->GetValue());
+}
+
+/**
+* @brief multiplication function of baseline, result is allocated in the literal container
+*/
+std::shared_ptr<Literal> BaselineMul(std::shared_ptr<Operand> a, std::shared_ptr<Operand> b) {
+  return std::make_shared<Literal>(a->GetValue() * b->GetValue());
+}
+
+/**
+* @brief division function of baseline, result is allocated in the literal container
+*/
+std::shared_ptr<Literal> BaselineDiv(std::shared_ptr<Operand> a, std::shared_ptr<Operand> b) {
+  return std::make_shared<Literal>(a->GetValue() / b->GetValue());
+}
+
+/**
+* @brief unary minus function of baseline, result is allocated in the literal container
+*/
+std::shared_ptr<Literal> BaselineUnaryMinus(std::shared_ptr<Operand> a) {
+  return std::make_shared<Literal>(-(a->GetValue()));
+}
+
+/**
+* @brief maximum function of baseline, result is allocated in the literal container
+*/
+std::shared_ptr<Literal> BaselineMax(std::vector<std::shared_ptr<Operand>> args) {
+  return std::make_shared<Literal>(args[0]->GetValue() > args[1]->GetValue() ? args[0]->GetValue() : args[1]->GetValue());
+}
+
+/**
+* @brief node of expression evaluated in baseline style
+* @details operation is performed through virtual Operation::DoOperation with callback of baseline,
+* which takes operands and returns result through shared pointers, nodes without operation push literal or variable
+*/
+struct VirtualNode {
+  std::shared_ptr<Operation> operation;   ///< performed operation or nullptr
+  Value value;                            ///< pushed value if there is no operation
+};
+
+/**
+* @brief function of building baseline style nodes of compiled expression
+* @param[in] program - compiled expression made of LoadBase operations
+* @param[in] variables - variables bound to slots of program
+* @return nodes in post-order
+* @throw std::exception if program has instructions which are not supported
+*/
+std::vector<VirtualNode> BuildVirtual(const CompiledExpression& program, std::vector<Variable>& variables) {
+  auto add = std::make_shared<BinaryOperator>("+", 1, BaselineAdd);
+  auto sub = std::make_shared<BinaryOperator>("-", 1, BaselineSub);
+  auto mul = std::make_shared<BinaryOperator>("*", 2, BaselineMul);
+  auto div = std::make_shared<BinaryOperator>("/", 2, BaselineDiv);
+  auto unaryMinus = std::make_shared<PreficsOperator>("-", 3, BaselineUnaryMinus);
+  auto max = std::make_shared<Function>("max", 2, BaselineMax);
+
+  std::vector<VirtualNode> nodes;
+  for (auto& instruction : program.GetProgram())
+    switch (instruction.code) {
+    case CompiledExpression::OpCode::PUSH_LITERAL:
+      nodes.push_back({ nullptr, Value(program.GetLiteral(instruction.arg)) });
+      break;
+    case CompiledExpression::OpCode::PUSH_VARIABLE:
+    case CompiledExpression::OpCode::LOAD_VARIABLE:
+      nodes.push_back({ nullptr, Value(&variables[instruction.arg]) });
+      break;
+    case CompiledExpression::OpCode::ADD:
+      nodes.push_back({ add, {} });
+      break;
+    case CompiledExpression::OpCode::SUB:
+      nodes.push_back({ sub, {} });
+      break;
+    case CompiledExpression::OpCode::MUL:
+      nodes.push_back({ mul, {} });
+      break;
+    case CompiledExpression::OpCode::DIV:
+      nodes.push_back({ div, {} });
+      break;
+    case CompiledExpression::OpCode::NEG:
+      nodes.push_back({ unaryMinus, {} });
+      break;
+    case CompiledExpression::OpCode::MAX:
+      nodes.push_back({ max, {} });
+      break;
+    case CompiledExpression::OpCode::RETURN:
+      break;
+    default:
+      throw std::runtime_error("Instruction is not supported by baseline style evaluation");
+    }
+  return nodes;
+}
+
+/**
+* @brief function of evaluating nodes in baseline style
+* @param[in] nodes - nodes in post-order
+* @param[in/out] storage - storage for stack of values
+* @param[in] capacity - size of storage
+* @return result of evaluating
+*/
+double EvaluateVirtual(const std::vector<VirtualNode>& nodes, Value* storage, size_t capacity) {
+  Operation::DataStack dataStack(storage, capacity);
+  for (auto& node : nodes)
+    if (node.operation != nullptr)
+      node.operation->DoOperation(dataStack);
+    else
+      dataStack.push(node.value);
+  return dataStack.top().GetValue();
+}
+
+/**
+* @brief function of measuring time of evaluations
+* @param[in] name - name of way of evaluating
+* @param[in] evaluate - function evaluating expression with given number of evaluation
+* @return nanoseconds per evaluation
+*/
+template<typename Evaluator>
+double Measure(const std::string& name, Evaluator evaluate) {
+  volatile double sink = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < EVALUATIONS; ++i)
+    sink = sink + evaluate(i);
+  auto end = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(end - begin).count() / EVALUATIONS;
+  std::cout << "  " << name << ": " << ns << " ns" << std::endl;
+  return ns;
+}
+
+/**
+* @brief function of benchmark of one expression
+* @param[in] expression - expression of LoadBase operations with variables
+* @throw std::exception if baseline style evaluation gives other result than interpreter
+*/
+void Benchmark(const std::string& expression) {
+  CompiledExpression program = Compile(expression);
+  std::vector<Variable> variables;
+  for (size_t slot = 0; slot < program.GetVariablesCount(); ++slot)
+    variables.emplace_back(program.GetVariableName(slot));
+  std::vector<Variable*> pointers;
+  for (auto& variable : variables)
+    pointers.push_back(&variable);
+  VariableBinding binding(pointers);
+  std::vector<VirtualNode> nodes = BuildVirtual(program, variables);
+  std::vector<Value> storage(nodes.size());
+  TieredExpression tiered(program);
+  tiered.Promote();
+
+  auto set = [&variables](size_t i) {
+    for (size_t slot = 0; slot < variables.size(); ++slot)
+      variables[slot].SetValue(0.5 * static_cast<double>(i % 1000) + slot);
+  };
+  set(1);
+  if (EvaluateVirtual(nodes, storage.data(), storage.size()) != Evaluate(program, binding))
+    throw std::runtime_error("Results of " + expression + " differ");
+  std::cout << expression << std::endl;
+  double baseline = Measure("virtual DoOperation (baseline style)", [&](size_t i) {
+    set(i);
+    return EvaluateVirtual(nodes, storage.data(), storage.size());
+  });
+  double interpreted = Measure("interpreter", [&](size_t i) {
+    set(i);
+    return Evaluate(program, binding);
+  });
+  std::cout << "  speedup of interpreter: " << baseline / interpreted << std::endl;
+  if (tiered.IsNative()) {
+    double native = Measure("machine code", [&](size_t i) {
+      set(i);
+      return tiered.Evaluate(binding);
+    });
+    std::cout << "  speedup of machine code: " << baseline / native << std::endl;
+  }
+}
+
+int main(void) {
+  OperationsDescription& dstr = OperationsDescription::GetInstance();
+  LoadBase(dstr);
+  try {
+    Benchmark("x + y * 2 - x / (y + 3)");
+    Benchmark("max(x * y, -x) + (x - y) * (x + y) / (x * 2 + 1)");
+    Benchmark("((x + 1) * (y - 2) + (x - 3) * (y + 4)) / (max(x, y) + 5) - -x * y");
+  }
+  catch (const std::exception& error) {
+    std::cout << error.what() << std::endl;
+    dstr.Clear();
+    return 1;
+  }
+  dstr.Clear();
+  return 0;
+}
\ No newline at end of file
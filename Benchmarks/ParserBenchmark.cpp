@@ -0,0 +1,290 @@
+#include "../Calculator/BaseOperations/BaseOperation.h"
+#include "../Calculator/Compiler/Compiler.h"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <stack>
+
+/**
+* @brief number of parses of every expression by every way
+*/
+constexpr size_t PARSES = 2000;
+
+/**
+* @brief class of parser of baseline
+* @details operators are found by scan of range of multimap with virtual GetType and their priorities are compared
+* through dynamic_cast like in Calculate of baseline. Operations are added into the same program as Compile adds them,
+* so only resolving of operations differs from Compile.
+*/
+class BaselineParser {
+public:
+  /**
+  * @brief constructor, operations are taken from current set of operations
+  */
+  BaselineParser(void) : snapshot(OperationsDescription::GetInstance().GetSnapshot()) {
+    for (auto& entry : snapshot->GetOperators())
+      operators.insert({ entry.name, Resolve(entry) });
+    for (auto& entry : snapshot->GetFunctions())
+      functions.insert({ entry.name, Resolve(entry) });
+    for (auto& entry : snapshot->GetBrackets())
+      brackets.insert({ entry.name, Resolve(entry) });
+  }
+
+  /**
+  * @brief method of parsing expression
+  * @param[in] expression - expression in string form
+  * @return compiled expression
+  * @throw std::exception if expression is not valid
+  */
+  CompiledExpression Parse(const std::string& expression) {
+    CompiledExpression program;
+    operationStack = {};
+    ElementType prevElementType = ElementType::BINARY;
+    std::vector<Token> tokens;
+    Separate(expression, *snapshot, tokens);
+    for (size_t i = 0; i < tokens.size(); ++i)
+      switch (tokens[i].GetType()) {
+      case Token::Type::DELIMETR_ARGS:
+        while (!operationStack.empty() && operationStack.top().operation->GetType() != ElementType::FUNCTION)
+          Pop(program);
+        if (operationStack.empty())
+          throw std::runtime_error("Unexpected ,");
+        prevElementType = ElementType::DELIMETR_ARGS;
+        break;
+      case Token::Type::LITERAL:
+        program.AddLiteral(std::stod(std::string(tokens[i].GetName())));
+        prevElementType = ElementType::LITERAL;
+        break;
+      case Token::Type::FUNCTION:
+        if (i + 1 >= tokens.size() || !tokens[i + 1].IsSimbol(SIMBOL_BEFORE_ARGS))
+          throw std::runtime_error("Function call expected");
+        operationStack.push(functions.find(tokens[i].GetName())->second);
+        prevElementType = ElementType::FUNCTION;
+        break;
+      case Token::Type::BRACKET:
+        prevElementType = ProcessBracket(program, tokens[i], prevElementType);
+        break;
+      case Token::Type::OPERATOR:
+        prevElementType = ProcessOperator(program, tokens[i], prevElementType);
+        break;
+      case Token::Type::VARIABLE:
+        program.AddVariable(tokens[i].GetName(), tokens[i].GetSymbol());
+        prevElementType = ElementType::VARIABLE;
+        break;
+      }
+    while (!operationStack.empty()) {
+      if (operationStack.top().operation->GetType() == ElementType::OPEN_BRACKET ||
+          operationStack.top().operation->GetType() == ElementType::FUNCTION)
+        throw std::runtime_error("Unexpected bracket");
+      Pop(program);
+    }
+    program.AddReturn();
+    return program;
+  }
+private:
+  /**
+  * @brief struct of operation found by name
+  */
+  struct Resolved {
+    std::shared_ptr<Operation> operation;     ///< operation
+    const OperationDescriptor* descriptor;    ///< descriptor which operation is added into program by
+  };
+
+  /**
+  * @brief method of finding descriptor of operation
+  * @param[in] entry - named operation
+  * @return operation with its descriptor
+  */
+  Resolved Resolve(const OperationsSnapshot::Entry& entry) const {
+    return { entry.operation, &snapshot->GetDescriptor(entry.symbol, entry.operation->GetType()) };
+  }
+
+  /**
+  * @brief method of adding top operation from stack into program
+  * @param[in/out] program - program
+  */
+  void Pop(CompiledExpression& program) {
+    program.AddOperation(*operationStack.top().descriptor);
+    operationStack.pop();
+  }
+
+  /**
+  * @brief method of finding operator by scan of range of operators with the same name
+  * @param[in] name - name of operator
+  * @param[in] type - type of operator
+  * @return operator or nullptr if there is no operator
+  */
+  const Resolved* GetOperator(std::string_view name, ElementType type) const {
+    for (auto result = operators.find(name); result != operators.end() && result->first == name; result++)
+      if (result->second.operation->GetType() == type)
+        return &result->second;
+    return nullptr;
+  }
+
+  /**
+  * @brief method of check that operation is to be popped off the stack
+  * @param[in] binaryOperator - the binary operator that is next to the top of the stack
+  * @param[in] other - operation on the top of the stack
+  * @return true if pop is necessary, false otherwise
+  */
+  static bool IsOperationPoped(const BinaryOperator& binaryOperator, std::shared_ptr<Operation> other) {
+    if (other->GetType() == ElementType::PREFICS)
+      return dynamic_cast<PreficsOperator*>(other.get())->GetPriority() > binaryOperator.GetPriority();
+    else if (other->GetType() == ElementType::BINARY) {
+      if (dynamic_cast<BinaryOperator*>(other.get())->GetAssociative() == BinaryOperator::Associative::RIGHT)
+        return dynamic_cast<BinaryOperator*>(other.get())->GetPriority() > binaryOperator.GetPriority();
+      else
+        return dynamic_cast<BinaryOperator*>(other.get())->GetPriority() == binaryOperator.GetPriority() ||
+               dynamic_cast<BinaryOperator*>(other.get())->GetPriority() > binaryOperator.GetPriority();
+    }
+    return false;
+  }
+
+  /**
+  * @brief method of resolving the token "operator"
+  * @param[in/out] program - program
+  * @param[in] operation - operator's token
+  * @param[in] prevElementType - the type of the previous element
+  * @return resolved type
+  * @throw std::exception if operator can not be resolved
+  */
+  ElementType ProcessOperator(CompiledExpression& program, const Token& operation, ElementType prevElementType) {
+    bool operand = prevElementType == ElementType::CLOSE_BRACKET || prevElementType == ElementType::LITERAL ||
+                   prevElementType == ElementType::POSTFICS || prevElementType == ElementType::SIMBOL_AFTER_ARGS ||
+                   prevElementType == ElementType::VARIABLE;
+    const Resolved* finalOperator = nullptr;
+    if (!operand && (finalOperator = GetOperator(operation.GetName(), ElementType::PREFICS)) != nullptr) {
+      operationStack.push(*finalOperator);
+      return ElementType::PREFICS;
+    }
+    if (operand && (finalOperator = GetOperator(operation.GetName(), ElementType::BINARY)) != nullptr) {
+      while (!operationStack.empty() &&
+             IsOperationPoped(*dynamic_cast<BinaryOperator*>(finalOperator->operation.get()), operationStack.top().operation))
+        Pop(program);
+      operationStack.push(*finalOperator);
+      return ElementType::BINARY;
+    }
+    if (operand && (finalOperator = GetOperator(operation.GetName(), ElementType::POSTFICS)) != nullptr) {
+      program.AddOperation(*finalOperator->descriptor);
+      return ElementType::POSTFICS;
+    }
+    throw std::runtime_error("Unexpected " + std::string(operation.GetName()));
+  }
+
+  /**
+  * @brief method of resolving the token "bracket"
+  * @param[in/out] program - program
+  * @param[in] operation - bracket's token
+  * @param[in] prevElementType - the type of the previous element
+  * @return resolved type
+  * @throw std::exception if bracket has no pare
+  */
+  ElementType ProcessBracket(CompiledExpression& program, const Token& operation, ElementType prevElementType) {
+    if (operation.IsSimbol(SIMBOL_BEFORE_ARGS) && prevElementType == ElementType::FUNCTION)
+      return ElementType::SIMBOL_BEFORE_ARGS;
+    std::string pare;
+    auto bracket = brackets.find(operation.GetName());
+    if (bracket != brackets.end()) {
+      if (bracket->second.operation->GetType() == ElementType::OPEN_BRACKET) {
+        operationStack.push(bracket->second);
+        return ElementType::OPEN_BRACKET;
+      }
+      pare = dynamic_cast<CloseBracket*>(bracket->second.operation.get())->GetPare();
+    }
+    while (!operationStack.empty()) {
+      const std::shared_ptr<Operation>& top = operationStack.top().operation;
+      if (operation.IsSimbol(SIMBOL_AFTER_ARGS) && top->GetType() == ElementType::FUNCTION) {
+        Pop(program);
+        return ElementType::SIMBOL_AFTER_ARGS;
+      }
+      else if (top->GetType() == ElementType::OPEN_BRACKET && top->GetTokenName() == pare) {
+        Pop(program);
+        return ElementType::CLOSE_BRACKET;
+      }
+      else if (top->GetType() == ElementType::OPEN_BRACKET || top->GetType() == ElementType::FUNCTION)
+        throw std::runtime_error("Unexpected bracket " + top->GetTokenName());
+      else
+        Pop(program);
+    }
+    throw std::runtime_error("Unexpected bracket " + std::string(operation.GetName()));
+  }
+
+  std::shared_ptr<const OperationsSnapshot> snapshot;            ///< operations which expressions are separated by
+  std::multimap<std::string, Resolved, std::less<>> operators;   ///< operators by name
+  std::map<std::string, Resolved, std::less<>> functions;        ///< functions by name
+  std::map<std::string, Resolved, std::less<>> brackets;         ///< brackets by name
+  std::stack<Resolved> operationStack;                           ///< stack of operations
+};
+
+/**
+* @brief function of making operator-heavy expression
+* @param[in] terms - number of terms
+* @param[in] depth - maximum depth of nested brackets, every 8 terms are put in brackets
+* @return expression with prefics, binary and postfics operators of all priorities
+*/
+std::string MakeExpression(size_t terms, size_t depth) {
+  static const char* const parts[] = { " -x * --y", " - -(x / 2)", " + y++ * -x", " / --x - y--", " * max(-x, y * 2)", " * (x = y + 1)" };
+  std::string expression = "x";
+  for (size_t i = 0; i < terms; ++i) {
+    expression += parts[i % (sizeof(parts) / sizeof(parts[0]))];
+    if (i % 8 == 7 && i / 8 < depth)
+      expression = "(" + expression + ")";
+  }
+  return expression;
+}
+
+/**
+* @brief function of measuring time of parses
+* @param[in] name - name of way of parsing
+* @param[in] parse - function parsing expression
+* @return microseconds per parse
+*/
+template<typename Parser>
+double Measure(const std::string& name, Parser parse) {
+  volatile size_t sink = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < PARSES; ++i)
+    sink = sink + parse();
+  auto end = std::chrono::steady_clock::now();
+  double us = std::chrono::duration<double, std::micro>(end - begin).count() / PARSES;
+  std::cout << "  " << name << ": " << us << " us" << std::endl;
+  return us;
+}
+
+/**
+* @brief function of benchmark of one expression
+* @param[in] terms - number of terms
+* @param[in] depth - depth of nested brackets
+* @throw std::exception if baseline style parser gives other program than Compile
+*/
+void Benchmark(size_t terms, size_t depth) {
+  std::string expression = MakeExpression(terms, depth);
+  BaselineParser baselineParser;
+  if (baselineParser.Parse(expression).GetProgram().size() != Compile(expression).GetProgram().size())
+    throw std::runtime_error("Programs of " + std::to_string(terms) + " terms differ");
+  std::cout << terms << " terms, " << expression.size() << " characters" << std::endl;
+  double baseline = Measure("dynamic_cast and multimap scan (baseline style)", [&]() {
+    return baselineParser.Parse(expression).GetProgram().size();
+  });
+  double compiled = Measure("Compile with operator descriptors", [&]() {
+    return Compile(expression).GetProgram().size();
+  });
+  std::cout << "  speedup: " << baseline / compiled << std::endl;
+}
+
+int main(void) {
+  OperationsDescription& dstr = OperationsDescription::GetInstance();
+  LoadBase(dstr);
+  try {
+    Benchmark(64, 8);
+    Benchmark(512, 64);
+    Benchmark(4096, 200);
+  }
+  catch (const std::exception& error) {
+    std::cout << error.what() << std::endl;
+    dstr.Clear();
+    return 1;
+  }
+  dstr.Clear();
+  return 0;
+}
\ No newline at end of file
@@ -1,10 +1,100 @@
 #include "API.h"
 
+void NameTrie::Insert(const std::string& name, Kind kind, uint32_t symbol) {
+  unsigned node = 0;
+  for (char symbol : name) {
+    unsigned char index = static_cast<unsigned char>(symbol);
+    if (index >= ALPHABET)
+      throw std::runtime_error(("Unexpected symbol in name " + name).c_str());
+    if (nodes[node].next[index] == 0) {
+      nodes[node].next[index] = static_cast<unsigned>(nodes.size());
+      nodes.emplace_back();
+    }
+    node = nodes[node].next[index];
+  }
+  nodes[node].kind = kind;
+  nodes[node].symbol = symbol;
+}
+
+size_t NameTrie::Match(std::string_view text, size_t pos, Kind& kind, uint32_t& symbol) const {
+  size_t length = 0;
+  unsigned node = 0;
+  kind = Kind::NONE;
+  symbol = 0;
+  for (size_t i = pos; i < text.size(); ++i) {
+    unsigned char index = static_cast<unsigned char>(text[i]);
+    if (index >= ALPHABET || nodes[node].next[index] == 0)
+      break;
+    node = nodes[node].next[index];
+    if (nodes[node].kind != Kind::NONE) {
+      kind = nodes[node].kind;
+      symbol = nodes[node].symbol;
+      length = i - pos + 1;
+    }
+  }
+  return length;
+}
+
+void NameTrie::Clear(void) {
+  nodes.assign(1, Node{});
+}
+
+SymbolTable& SymbolTable::GetInstance(void) {
+  static SymbolTable self;
+  return self;
+}
+
+uint32_t SymbolTable::Intern(std::string_view name) {
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto id = ids.find(name);
+    if (id != ids.end())
+      return id->second;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex);
+  auto id = ids.find(name);
+  if (id != ids.end())
+    return id->second;
+
+  uint32_t next = count.load(std::memory_order_relaxed);
+  if (next / CHUNK_SIZE >= MAX_CHUNKS)
+    throw std::runtime_error("Too many names");
+  auto& chunk = chunks[next / CHUNK_SIZE];
+  if (!chunk)
+    chunk = std::make_unique<std::string[]>(CHUNK_SIZE);
+  std::string& stored = chunk[next % CHUNK_SIZE];
+  stored = name;
+  ids.emplace(stored, next);
+  count.store(next + 1, std::memory_order_release);
+  return next;
+}
+
+uint32_t SymbolTable::Find(std::string_view name) const {
+  std::shared_lock<std::shared_mutex> lock(mutex);
+  auto id = ids.find(name);
+  return id == ids.end() ? NONE : id->second;
+}
+
+const std::string& SymbolTable::GetName(uint32_t id) const {
+  return chunks[id / CHUNK_SIZE][id % CHUNK_SIZE];
+}
+
+uint32_t SymbolTable::GetCount(void) const {
+  return count.load(std::memory_order_acquire);
+}
+
 OperationsDescription& OperationsDescription::GetInstance(void) {
   static OperationsDescription self;
   return self;
 }
 
+std::unique_ptr<OperationsDescription> OperationsDescription::CreateStaging(void) {
+  std::unique_ptr<OperationsDescription> storage(new OperationsDescription());
+  storage->staging = true;
+  return storage;
+}
+
 bool OperationsDescription::IsBeginigFunctionName(const char symbol) {
   return isalpha(symbol) && symbol != DELIMETR_ARGS && symbol != SIMBOL_BEFORE_ARGS && symbol != SIMBOL_AFTER_ARGS;
 }
@@ -17,8 +107,8 @@ bool OperationsDescription::IsBeginingBracketName(const char symbol) {
   return (isalpha(symbol) || ispunct(symbol)) && symbol != DELIMETR_ARGS;
 }
 
-bool OperationsDescription::IsValidFunctionName(const std::string& name) {
-  if (!IsBeginigFunctionName(name[0]))
+bool OperationsDescription::IsValidFunctionName(std::string_view name) {
+  if (name.empty() || !IsBeginigFunctionName(name[0]))
     return false;
   for (int i = 1; i < name.size(); i++)
     if (!isalnum(name[i]) || name[i] == DELIMETR_ARGS || name[i] == SIMBOL_BEFORE_ARGS || name[i] == SIMBOL_AFTER_ARGS)
@@ -26,8 +116,8 @@ bool OperationsDescription::IsValidFunctionName(const std::string& name) {
   return true;
 }
 
-bool OperationsDescription::IsValidOperatorName(const std::string& name) {
-  if (!IsBeginingOperatorName(name[0]))
+bool OperationsDescription::IsValidOperatorName(std::string_view name) {
+  if (name.empty() || !IsBeginingOperatorName(name[0]))
     return false;
   for (int i = 1; i < name.size(); i++)
     if (!(isalnum(name[i]) || ispunct(name[i])) || name[i] == DELIMETR_ARGS || name[i] == SIMBOL_BEFORE_ARGS || name[i] == SIMBOL_AFTER_ARGS)
@@ -35,8 +125,8 @@ bool OperationsDescription::IsValidOperatorName(const std::string& name) {
   return true;
 }
 
-bool OperationsDescription::IsValidBracketName(const std::string& name) {
-  if (!IsBeginingBracketName(name[0]))
+bool OperationsDescription::IsValidBracketName(std::string_view name) {
+  if (name.empty() || !IsBeginingBracketName(name[0]))
     return false;
   for (int i = 1; i < name.size(); i++)
     if (!(isalnum(name[i]) || ispunct(name[i])) || name[i] == DELIMETR_ARGS)
@@ -44,39 +134,43 @@ bool OperationsDescription::IsValidBracketName(const std::string& name) {
   return true;
 }
 
-bool OperationsDescription::CheckOperation(const std::string& name) const {
-  if (!IsValidBracketName(name) && !IsValidFunctionName(name) && !IsValidOperatorName(name))
-    return false;
-  return functions.find(name) != functions.end() || operators.find(name) != operators.end() || brackets.find(name) != brackets.end();
+bool OperationsDescription::CheckOperation(std::string_view name) const {
+  return GetSnapshot()->CheckOperation(name);
 }
 
-bool OperationsDescription::CheckFunction(const std::string& operation) const {
-  if (!IsValidFunctionName(operation))
-    return false;
-  return functions.find(operation) != functions.end();
+bool OperationsDescription::CheckFunction(std::string_view operation) const {
+  return GetSnapshot()->CheckFunction(operation);
 }
 
-bool OperationsDescription::CheckOperator(const std::string& operation) const {
-  if (!IsValidOperatorName(operation))
-    return false;
-  return operators.find(operation) != operators.end();
+bool OperationsDescription::CheckOperator(std::string_view operation) const {
+  return GetSnapshot()->CheckOperator(operation);
 };
 
-bool OperationsDescription::CheckBracket(const std::string& operation) const {
-  if (!IsValidBracketName(operation))
-    return false;
-  return brackets.find(operation) != brackets.end();
+bool OperationsDescription::CheckBracket(std::string_view operation) const {
+  return GetSnapshot()->CheckBracket(operation);
 };
 
-std::shared_ptr<Operation>  OperationsDescription::GetFunction(const std::string& operation) const {
-  return functions.find(operation)->second;
+std::shared_ptr<Operation>  OperationsDescription::GetFunction(std::string_view operation) const {
+  return GetSnapshot()->GetFunction(operation);
 };
 
-std::shared_ptr<Operation>  OperationsDescription::GetBracket(const std::string& operation) const {
-  return brackets.find(operation)->second;
+std::shared_ptr<Operation>  OperationsDescription::GetBracket(std::string_view operation) const {
+  return GetSnapshot()->GetBracket(operation);
 };
 
-std::shared_ptr<Operation>  OperationsDescription::GetOperator(const std::string& operation, ElementType type) const {
+std::shared_ptr<Operation>  OperationsDescription::GetOperator(std::string_view operation, ElementType type) const {
+  return GetSnapshot()->GetOperator(operation, type);
+}
+
+size_t OperationsDescription::MatchName(std::string_view expression, size_t pos, NameTrie::Kind& kind, uint32_t& symbol) const {
+  return GetSnapshot()->MatchName(expression, pos, kind, symbol);
+}
+
+std::shared_ptr<const OperationsSnapshot> OperationsDescription::GetSnapshot(void) const {
+  return std::atomic_load(&snapshot);
+}
+
+std::shared_ptr<Operation> OperationsDescription::FindOperator(std::string_view operation, ElementType type) const {
   auto result = operators.find(operation);
   for (result; result != operators.end() && result->first == operation; result++) {
     if (result->second->GetType() == type)
@@ -85,14 +179,28 @@ std::shared_ptr<Operation>  OperationsDescription::GetOperator(const std::string
   return nullptr;
 }
 
+void OperationsDescription::Publish(void) {
+  if (staging)
+    return;
+  auto toEntries = [this](auto& storage) {
+    std::vector<OperationsSnapshot::Entry> entries;
+    entries.reserve(storage.size());
+    for (auto& operation : storage)
+      entries.push_back({ operation.first, symbols.Intern(operation.first), operation.second, deferred.count(operation.second.get()) != 0 });
+    return entries;
+  };
+  std::atomic_store(&snapshot, std::shared_ptr<const OperationsSnapshot>(
+    std::make_shared<OperationsSnapshot>(toEntries(functions), toEntries(operators), toEntries(brackets), symbols, ++generation)));
+}
+
 void OperationsDescription::AddFunction(std::shared_ptr<Operation> operation) {
   if (functions.find(operation->GetTokenName()) != functions.end() ||
       operators.find(operation->GetTokenName()) != operators.end() ||
       brackets.find(operation->GetTokenName()) != brackets.end())
-    throw std::exception(("Trying to override a function or operator " + operation->GetTokenName()).c_str());
+    throw std::runtime_error(("Trying to override a function or operator " + operation->GetTokenName()).c_str());
 
   if (!IsValidFunctionName(operation->GetTokenName()))
-    throw std::exception(("\"" + operation->GetTokenName() + "\"" + " - invalid name for function").c_str());
+    throw std::runtime_error(("\"" + operation->GetTokenName() + "\"" + " - invalid name for function").c_str());
 
   functions.insert(std::pair(operation->GetTokenName(), operation));
 }
@@ -100,15 +208,15 @@ void OperationsDescription::AddFunction(std::shared_ptr<Operation> operation) {
 void OperationsDescription::AddOperator(std::shared_ptr<Operation> operation) {
   if (brackets.find(operation->GetTokenName()) != brackets.end() ||
       functions.find(operation->GetTokenName()) != functions.end())
-    throw std::exception(("Unable to add operator " + operation->GetTokenName()).c_str());
+    throw std::runtime_error(("Unable to add operator " + operation->GetTokenName()).c_str());
   if (operation->GetType() == ElementType::PREFICS &&
-      this->GetOperator(operation->GetTokenName(), ElementType::PREFICS) != nullptr)
-    throw std::exception(("Unable to add operator " + operation->GetTokenName()).c_str());
+      FindOperator(operation->GetTokenName(), ElementType::PREFICS) != nullptr)
+    throw std::runtime_error(("Unable to add operator " + operation->GetTokenName()).c_str());
   if ((operation->GetType() == ElementType::BINARY || operation->GetType() == ElementType::POSTFICS) &&
-      (this->GetOperator(operation->GetTokenName(), ElementType::BINARY) != nullptr || this->GetOperator(operation->GetTokenName(), ElementType::POSTFICS) != nullptr))
-    throw std::exception(("Unable to add operator " + operation->GetTokenName()).c_str());
+      (FindOperator(operation->GetTokenName(), ElementType::BINARY) != nullptr || FindOperator(operation->GetTokenName(), ElementType::POSTFICS) != nullptr))
+    throw std::runtime_error(("Unable to add operator " + operation->GetTokenName()).c_str());
   if (!IsValidOperatorName(operation->GetTokenName()))
-    throw std::exception((operation->GetTokenName() + " - invalid name for operator").c_str());
+    throw std::runtime_error((operation->GetTokenName() + " - invalid name for operator").c_str());
   operators.insert(std::pair(operation->GetTokenName(), operation));
 }
 
@@ -116,31 +224,381 @@ void OperationsDescription::AddBracket(std::shared_ptr<Operation> operation) {
   if (functions.find(operation->GetTokenName()) != functions.end() ||
       operators.find(operation->GetTokenName()) != operators.end() ||
       brackets.find(operation->GetTokenName()) != brackets.end())
-    throw std::exception(("Unable to add bracket " + operation->GetTokenName()).c_str());
+    throw std::runtime_error(("Unable to add bracket " + operation->GetTokenName()).c_str());
   if(!IsValidBracketName(operation->GetTokenName()))
-    throw std::exception((operation->GetTokenName() + " - invalid name for bracket").c_str());
+    throw std::runtime_error((operation->GetTokenName() + " - invalid name for bracket").c_str());
   brackets.insert(std::pair(operation->GetTokenName(), operation));
 }
 
-void OperationsDescription::LoadOperation(std::shared_ptr<Operation> operation) {
+bool OperationsDescription::Add(std::shared_ptr<Operation> operation) {
   if (operation->GetType() == ElementType::FUNCTION)
     AddFunction(operation);
   else if (operation->GetType() == ElementType::BINARY || operation->GetType() == ElementType::PREFICS || operation->GetType() == ElementType::POSTFICS)
     AddOperator(operation);
   else if (operation->GetType() == ElementType::OPEN_BRACKET || operation->GetType() == ElementType::CLOSE_BRACKET)
     AddBracket(operation);
+  else
+    return false;
+  return true;
+}
+
+std::vector<std::shared_ptr<Operation>> OperationsDescription::GetOperations(void) {
+  std::lock_guard<std::mutex> lock(writeMutex);
+  std::vector<std::shared_ptr<Operation>> operations;
+  operations.reserve(functions.size() + operators.size() + brackets.size());
+  for (auto& operation : functions)
+    operations.push_back(operation.second);
+  for (auto& operation : operators)
+    operations.push_back(operation.second);
+  for (auto& operation : brackets)
+    operations.push_back(operation.second);
+  return operations;
+}
+
+void OperationsDescription::LoadOperation(std::shared_ptr<Operation> operation) {
+  std::lock_guard<std::mutex> lock(writeMutex);
+  if (Add(operation))
+    Publish();
+}
+
+void OperationsDescription::Merge(const std::vector<const OperationsDescription*>& stagings) {
+  std::lock_guard<std::mutex> lock(writeMutex);
+  std::string error;
+  for (auto staging : stagings) {
+    auto savedFunctions = functions;
+    auto savedOperators = operators;
+    auto savedBrackets = brackets;
+    try {
+      for (auto& operation : staging->functions)
+        Add(operation.second);
+      for (auto& operation : staging->operators)
+        Add(operation.second);
+      for (auto& operation : staging->brackets)
+        Add(operation.second);
+    }
+    catch (const std::exception& except) {
+      functions = std::move(savedFunctions);
+      operators = std::move(savedOperators);
+      brackets = std::move(savedBrackets);
+      if (error.empty())
+        error = except.what();
+    }
+  }
+  Publish();
+  if (!error.empty())
+    throw std::runtime_error(error.c_str());
 }
 
 void OperationsDescription::Clear(void) {
+  std::lock_guard<std::mutex> lock(writeMutex);
   functions.clear();
   operators.clear();
   brackets.clear();
+  deferred.clear();
+  Publish();
+}
+
+/**
+* @brief function of check that operation may replace stub
+* @param[in] stub - stub of operation
+* @param[in] operation - loaded operation
+* @return true if operations have the same name, type, priority, associativity, number of arguments and pare bracket
+*/
+static bool IsSameSignature(const Operation& stub, const Operation& operation) {
+  if (stub.GetTokenName() != operation.GetTokenName() || stub.GetType() != operation.GetType())
+    return false;
+  switch (stub.GetType()) {
+  case ElementType::PREFICS:
+    return dynamic_cast<const PreficsOperator&>(stub).GetPriority() == dynamic_cast<const PreficsOperator&>(operation).GetPriority();
+  case ElementType::BINARY:
+    return dynamic_cast<const BinaryOperator&>(stub).GetPriority() == dynamic_cast<const BinaryOperator&>(operation).GetPriority() &&
+           dynamic_cast<const BinaryOperator&>(stub).GetAssociative() == dynamic_cast<const BinaryOperator&>(operation).GetAssociative();
+  case ElementType::FUNCTION:
+    return dynamic_cast<const Function&>(stub).GetArgsNum() == dynamic_cast<const Function&>(operation).GetArgsNum();
+  case ElementType::CLOSE_BRACKET:
+    return dynamic_cast<const CloseBracket&>(stub).GetPare() == dynamic_cast<const CloseBracket&>(operation).GetPare();
+  default:
+    return true;
+  }
+}
+
+void OperationsDescription::Defer(const std::vector<std::shared_ptr<Operation>>& stubs, std::function<std::unique_ptr<OperationsDescription>(void)> loader) {
+  std::lock_guard<std::mutex> lock(writeMutex);
+  auto group = std::make_shared<Deferred>();
+  group->stubs = stubs;
+  group->loader = std::move(loader);
+  auto savedFunctions = functions;
+  auto savedOperators = operators;
+  auto savedBrackets = brackets;
+  try {
+    for (auto& stub : stubs)
+      if (!Add(stub))
+        throw std::runtime_error(("Unable to defer operation " + stub->GetTokenName()).c_str());
+  }
+  catch (...) {
+    functions = std::move(savedFunctions);
+    operators = std::move(savedOperators);
+    brackets = std::move(savedBrackets);
+    throw;
+  }
+  for (auto& stub : stubs)
+    deferred[stub.get()] = group;
+  Publish();
+}
+
+bool OperationsDescription::Resolve(uint32_t symbol) {
+  std::shared_ptr<Deferred> group;
+  {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    if (deferred.empty() || symbol >= symbols.GetCount())
+      return false;
+    const std::string& name = symbols.GetName(symbol);
+    auto find = [this, &group](const std::shared_ptr<Operation>& operation) {
+      auto found = deferred.find(operation.get());
+      if (found != deferred.end())
+        group = found->second;
+    };
+    if (auto function = functions.find(name); function != functions.end())
+      find(function->second);
+    if (auto bracket = brackets.find(name); bracket != brackets.end())
+      find(bracket->second);
+    for (auto op = operators.lower_bound(name); op != operators.end() && op->first == name; ++op)
+      find(op->second);
+    if (!group)
+      return false;
+  }
+
+  std::lock_guard<std::mutex> loadLock(group->loadMutex);
+  if (group->loaded)
+    return true;
+  if (!group->error.empty())
+    throw std::runtime_error(group->error.c_str());
+  try {
+    auto staging = group->loader();
+    auto findLoaded = [&staging](const Operation& stub) -> std::shared_ptr<Operation> {
+      if (stub.GetType() == ElementType::FUNCTION) {
+        auto found = staging->functions.find(stub.GetTokenName());
+        return found != staging->functions.end() ? found->second : nullptr;
+      }
+      if (stub.GetType() == ElementType::OPEN_BRACKET || stub.GetType() == ElementType::CLOSE_BRACKET) {
+        auto found = staging->brackets.find(stub.GetTokenName());
+        return found != staging->brackets.end() ? found->second : nullptr;
+      }
+      return staging->FindOperator(stub.GetTokenName(), stub.GetType());
+    };
+    if (staging->functions.size() + staging->operators.size() + staging->brackets.size() != group->stubs.size())
+      throw std::runtime_error(("Loaded operations do not match deferred operation " + group->stubs.front()->GetTokenName()).c_str());
+    for (auto& stub : group->stubs) {
+      auto operation = findLoaded(*stub);
+      if (!operation || !IsSameSignature(*stub, *operation))
+        throw std::runtime_error(("Loaded operations do not match deferred operation " + stub->GetTokenName()).c_str());
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+    auto savedFunctions = functions;
+    auto savedOperators = operators;
+    auto savedBrackets = brackets;
+    try {
+      for (auto& stub : group->stubs)
+        Remove(stub);
+      for (auto& operation : staging->functions)
+        Add(operation.second);
+      for (auto& operation : staging->operators)
+        Add(operation.second);
+      for (auto& operation : staging->brackets)
+        Add(operation.second);
+    }
+    catch (...) {
+      functions = std::move(savedFunctions);
+      operators = std::move(savedOperators);
+      brackets = std::move(savedBrackets);
+      throw;
+    }
+    for (auto& stub : group->stubs)
+      deferred.erase(stub.get());
+    group->loaded = true;
+    Publish();
+  }
+  catch (const std::exception& except) {
+    group->error = except.what();
+    throw;
+  }
+  return true;
+}
+
+void OperationsDescription::Remove(const std::shared_ptr<Operation>& operation) {
+  auto erase = [&operation](auto& storage) {
+    for (auto found = storage.lower_bound(operation->GetTokenName()); found != storage.end() && found->first == operation->GetTokenName(); ++found)
+      if (found->second == operation) {
+        storage.erase(found);
+        return;
+      }
+  };
+  erase(functions);
+  erase(operators);
+  erase(brackets);
+}
+
+/**
+* @brief descriptor returned by getters of snapshot when there is no operation
+*/
+static const OperationDescriptor NO_OPERATION;
+
+OperationsSnapshot::OperationsSnapshot(std::vector<Entry> functions, std::vector<Entry> operators, std::vector<Entry> brackets,
+                                       const SymbolTable& symbols, uint64_t generation)
+  : functions(std::move(functions)), operators(std::move(operators)), brackets(std::move(brackets)), symbols(&symbols), generation(generation) {
+  Index(this->functions, NameTrie::Kind::FUNCTION);
+  Index(this->operators, NameTrie::Kind::OPERATOR);
+  Index(this->brackets, NameTrie::Kind::BRACKET);
+}
+
+OperationDescriptor OperationsSnapshot::Describe(std::shared_ptr<Operation> operation, uint32_t symbol) const {
+  OperationDescriptor descriptor;
+  descriptor.type = operation->GetType();
+  descriptor.symbol = symbol;
+  descriptor.hasOperation = true;
+  descriptor.argsNum = 1;
+  descriptor.pure = operation->IsPure();
+  switch (descriptor.type) {
+  case ElementType::PREFICS:
+    descriptor.priority = dynamic_cast<PreficsOperator*>(operation.get())->GetPriority();
+    break;
+  case ElementType::BINARY: {
+    auto binary = dynamic_cast<BinaryOperator*>(operation.get());
+    descriptor.priority = binary->GetPriority();
+    descriptor.rightAssociative = binary->GetAssociative() == BinaryOperator::Associative::RIGHT;
+    descriptor.argsNum = 2;
+    break;
+  }
+  case ElementType::FUNCTION:
+    descriptor.argsNum = dynamic_cast<Function*>(operation.get())->GetArgsNum();
+    break;
+  case ElementType::OPEN_BRACKET:
+    descriptor.hasOperation = dynamic_cast<OpenBracket*>(operation.get())->HasOperation();
+    break;
+  case ElementType::CLOSE_BRACKET:
+    descriptor.pare = symbols->Find(dynamic_cast<CloseBracket*>(operation.get())->GetPare());
+    descriptor.hasOperation = false;
+    descriptor.argsNum = 0;
+    break;
+  default:
+    break;
+  }
+  descriptor.operation = std::move(operation);
+  return descriptor;
+}
+
+void OperationsSnapshot::Index(const std::vector<Entry>& entries, NameTrie::Kind kind) {
+  for (auto& entry : entries) {
+    if (entry.symbol >= table.size())
+      table.resize(size_t(entry.symbol) + 1);
+    table[entry.symbol][size_t(entry.operation->GetType())] = Describe(entry.operation, entry.symbol);
+    table[entry.symbol][size_t(entry.operation->GetType())].deferred = entry.deferred;
+    names.Insert(entry.name, kind, entry.symbol);
+  }
+}
+
+const OperationDescriptor& OperationsSnapshot::GetDescriptor(uint32_t symbol, ElementType type) const {
+  if (symbol >= table.size() || size_t(type) >= OPERATION_TYPES)
+    return NO_OPERATION;
+  return table[symbol][size_t(type)];
+}
+
+bool OperationsSnapshot::IsDeferred(uint32_t symbol) const {
+  if (symbol >= table.size())
+    return false;
+  for (auto& descriptor : table[symbol])
+    if (descriptor.deferred)
+      return true;
+  return false;
+}
+
+bool OperationsSnapshot::CheckOperation(std::string_view name) const {
+  uint32_t symbol = symbols->Find(name);
+  if (symbol >= table.size())
+    return false;
+  for (auto& descriptor : table[symbol])
+    if (descriptor.operation)
+      return true;
+  return false;
+}
+
+bool OperationsSnapshot::CheckFunction(std::string_view operation) const {
+  return GetFunction(symbols->Find(operation)) != nullptr;
+}
+
+bool OperationsSnapshot::CheckOperator(std::string_view operation) const {
+  uint32_t symbol = symbols->Find(operation);
+  return GetOperator(symbol, ElementType::PREFICS) || GetOperator(symbol, ElementType::BINARY) || GetOperator(symbol, ElementType::POSTFICS);
+}
+
+bool OperationsSnapshot::CheckBracket(std::string_view operation) const {
+  return CheckBracket(symbols->Find(operation));
+}
+
+std::shared_ptr<Operation> OperationsSnapshot::GetFunction(std::string_view operation) const {
+  return GetFunction(symbols->Find(operation));
+}
+
+std::shared_ptr<Operation> OperationsSnapshot::GetBracket(std::string_view operation) const {
+  return GetBracket(symbols->Find(operation));
+}
+
+std::shared_ptr<Operation> OperationsSnapshot::GetOperator(std::string_view operation, ElementType type) const {
+  return GetOperator(symbols->Find(operation), type);
+}
+
+bool OperationsSnapshot::CheckBracket(uint32_t symbol) const {
+  return GetBracket(symbol) != nullptr;
+}
+
+const std::shared_ptr<Operation>& OperationsSnapshot::GetFunction(uint32_t symbol) const {
+  return GetDescriptor(symbol, ElementType::FUNCTION).operation;
+}
+
+const std::shared_ptr<Operation>& OperationsSnapshot::GetBracket(uint32_t symbol) const {
+  const std::shared_ptr<Operation>& open = GetDescriptor(symbol, ElementType::OPEN_BRACKET).operation;
+  return open ? open : GetDescriptor(symbol, ElementType::CLOSE_BRACKET).operation;
+}
+
+const std::shared_ptr<Operation>& OperationsSnapshot::GetOperator(uint32_t symbol, ElementType type) const {
+  if (type != ElementType::PREFICS && type != ElementType::BINARY && type != ElementType::POSTFICS)
+    return NO_OPERATION.operation;
+  return GetDescriptor(symbol, type).operation;
+}
+
+size_t OperationsSnapshot::MatchName(std::string_view expression, size_t pos, NameTrie::Kind& kind, uint32_t& symbol) const {
+  return names.Match(expression, pos, kind, symbol);
+}
+
+const std::vector<OperationsSnapshot::Entry>& OperationsSnapshot::GetFunctions(void) const {
+  return functions;
+}
+
+const std::vector<OperationsSnapshot::Entry>& OperationsSnapshot::GetOperators(void) const {
+  return operators;
+}
+
+const std::vector<OperationsSnapshot::Entry>& OperationsSnapshot::GetBrackets(void) const {
+  return brackets;
+}
+
+uint64_t OperationsSnapshot::GetGeneration(void) const {
+  return generation;
 }
 
 BinaryOperator::Associative BinaryOperator::GetAssociative(void) const {
   return assotiative;
 }
 
+BinaryOperator::DoValueBinaryOperation BinaryOperator::GetValueOperation(void) const {
+  return doValueOperation;
+}
+
+bool BinaryOperator::IsPure(void) const {
+  return pure;
+}
+
 ElementType BinaryOperator::GetType(void) const {
   return ElementType::BINARY;
 };
@@ -151,13 +609,15 @@ std::string BinaryOperator::GetTokenName(void) const {
 
 void BinaryOperator::DoOperation(DataStack& dataStack) const {
   if (dataStack.size() < 2)
-    throw std::exception("Unexpected number of arguments");
+    throw std::runtime_error("Unexpected number of arguments");
   else {
-    std::shared_ptr<Operand> b = dataStack.top();
-    dataStack.pop();
-    std::shared_ptr<Operand> a = dataStack.top();
+    Value b = dataStack.top();
     dataStack.pop();
-    dataStack.push(doOperation(a, b));
+    Value& a = dataStack.top();
+    if (doValueOperation != nullptr)
+      a = doValueOperation(a, b);
+    else
+      a = doOperation(a.ToOperand(), b.ToOperand())->GetValue();
   }
 }
 
@@ -167,6 +627,14 @@ int PreficsOperator::GetPriority(void) const {
   return prioryty;
 };
 
+PreficsOperator::DoValuePreficsOperation PreficsOperator::GetValueOperation(void) const {
+  return doValueOperation;
+}
+
+bool PreficsOperator::IsPure(void) const {
+  return pure;
+}
+
 ElementType PreficsOperator::GetType(void) const {
   return ElementType::PREFICS;
 };
@@ -177,16 +645,26 @@ std::string PreficsOperator::GetTokenName(void) const {
 
 void PreficsOperator::DoOperation(DataStack& dataStack) const{
   if (dataStack.size() < 1)
-    throw std::exception("Unexpected number of arguments");
+    throw std::runtime_error("Unexpected number of arguments");
   else {
-    std::shared_ptr<Operand> a = dataStack.top();
-    dataStack.pop();
-    dataStack.push(doOperation(a));
+    Value& a = dataStack.top();
+    if (doValueOperation != nullptr)
+      a = doValueOperation(a);
+    else
+      a = doOperation(a.ToOperand())->GetValue();
   }
 };
 
 
 
+PostficsOperator::DoValuePostficsOperation PostficsOperator::GetValueOperation(void) const {
+  return doValueOperation;
+}
+
+bool PostficsOperator::IsPure(void) const {
+  return pure;
+}
+
 ElementType PostficsOperator::GetType(void) const {
   return ElementType::POSTFICS;
 };
@@ -197,16 +675,30 @@ std::string PostficsOperator::GetTokenName(void) const {
 
 void PostficsOperator::DoOperation(DataStack& dataStack) const {
   if (dataStack.size() < 1)
-    throw std::exception("Unexpected number of arguments");
+    throw std::runtime_error("Unexpected number of arguments");
   else {
-    std::shared_ptr<Operand> a = dataStack.top();
-    dataStack.pop();
-    dataStack.push(doOperation(a));
+    Value& a = dataStack.top();
+    if (doValueOperation != nullptr)
+      a = doValueOperation(a);
+    else
+      a = doOperation(a.ToOperand())->GetValue();
   }
 };
 
 
 
+OpenBracket::DoValueFunc OpenBracket::GetValueOperation(void) const {
+  return doValueOperation;
+}
+
+bool OpenBracket::HasOperation(void) const {
+  return doValueOperation != nullptr || doOperation != nullptr;
+}
+
+bool OpenBracket::IsPure(void) const {
+  return pure;
+}
+
 ElementType OpenBracket::GetType(void) const {
   return ElementType::OPEN_BRACKET;
 };
@@ -217,11 +709,14 @@ std::string OpenBracket::GetTokenName(void) const {
 
 void OpenBracket::DoOperation(DataStack& dataStack) const {
   if (dataStack.size() < 1)
-    throw std::exception("Unexpected number of arguments");
+    throw std::runtime_error("Unexpected number of arguments");
+  else if (doValueOperation != nullptr) {
+    Value& a = dataStack.top();
+    a = doValueOperation(a);
+  }
   else if (doOperation != nullptr) {
-    std::shared_ptr<Operand> a = dataStack.top();
-    dataStack.pop();
-    dataStack.push(doOperation(a));
+    Value& a = dataStack.top();
+    a = doOperation(a.ToOperand())->GetValue();
   }
 };
 
@@ -235,6 +730,10 @@ std::string CloseBracket::GetTokenName(void) const {
   return name;
 };
 
+bool CloseBracket::IsPure(void) const {
+  return true;
+}
+
 ElementType CloseBracket::GetType(void) const {
   return ElementType::CLOSE_BRACKET;
 }
@@ -245,25 +744,62 @@ void CloseBracket::DoOperation(DataStack& dataStack) const {
 
 
 
+Function::DoSpanFunc Function::GetSpanOperation(void) const {
+  return doSpanOperation;
+}
+
+Function::DoUnaryFunc Function::GetUnaryOperation(void) const {
+  return doUnaryOperation;
+}
+
+Function::DoBinaryFunc Function::GetBinaryOperation(void) const {
+  return doBinaryOperation;
+}
+
+int Function::GetArgsNum(void) const {
+  return argsNum;
+};
+
 std::string Function::GetTokenName(void) const {
   return name;
 };
 
+bool Function::IsPure(void) const {
+  return pure;
+}
+
 ElementType Function::GetType(void) const {
   return ElementType::FUNCTION;
 };
 
 void Function::DoOperation(DataStack& dataStack) const {
   if (dataStack.size() < argsNum)
-    throw std::exception("Unexpected number of arguments");
+    throw std::runtime_error("Unexpected number of arguments");
+  Value* args = dataStack.last(argsNum);
+  double result = 0;
+  if (doUnaryOperation != nullptr)
+    result = doUnaryOperation(args[0].GetValue());
+  else if (doBinaryOperation != nullptr)
+    result = doBinaryOperation(args[0].GetValue(), args[1].GetValue());
+  else if (doSpanOperation != nullptr && argsNum <= LOCAL_ARGS_NUM) {
+    double values[LOCAL_ARGS_NUM];
+    for (int i = 0; i < argsNum; i++)
+      values[i] = args[i].GetValue();
+    result = doSpanOperation(values, argsNum);
+  }
+  else if (doSpanOperation != nullptr) {
+    std::vector<double> values(argsNum);
+    for (int i = 0; i < argsNum; i++)
+      values[i] = args[i].GetValue();
+    result = doSpanOperation(values.data(), argsNum);
+  }
   else {
-    std::vector<std::shared_ptr<Operand>> args;
-    for (int i = 0; i < argsNum; i++) {
-      std::shared_ptr<Operand> a = dataStack.top();
-      dataStack.pop();
-      args.push_back(a);
-    }
-    std::reverse(args.begin(), args.end());
-    dataStack.push(doOperation(args));
+    std::vector<std::shared_ptr<Operand>> operands;
+    for (int i = 0; i < argsNum; i++)
+      operands.push_back(args[i].ToOperand());
+    result = doOperation(operands)->GetValue();
   }
+  for (int i = 0; i < argsNum; i++)
+    dataStack.pop();
+  dataStack.push(result);
 }
\ No newline at end of file
@@ -2,9 +2,493 @@
 
 #include "ExpressionElements.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+/**
+* @brief declaration of function exported by module, modules export Load(OperationsDescription&)
+*/
+#ifdef _WIN32
+#define MODULE_EXPORT extern "C" __declspec(dllexport)
+#define MODULE_CALL __cdecl
+#else
+#define MODULE_EXPORT extern "C" __attribute__((visibility("default")))
+#define MODULE_CALL
+#endif
+
+/**
+* @brief class of character trie of operation's names for longest-match search
+*/
+class NameTrie {
+public:
+  /**
+  * @brief enum class of the kind of name stored in trie
+  */
+  enum class Kind : unsigned char {
+    NONE,         ///< no name ends here
+    FUNCTION,     ///< function's name
+    OPERATOR,     ///< operator's name
+    BRACKET,      ///< bracket's name
+  };
+
+  /**
+  * @brief constructor, trie contains only root
+  */
+  NameTrie() : nodes(1) {};
+
+  /**
+  * @brief default copy constructor
+  */
+  NameTrie(const NameTrie&) = default;
+
+  /**
+  * @brief default move constructor
+  */
+  NameTrie(NameTrie&&) = default;
+
+  /**
+  * @brief default copy operator
+  */
+  NameTrie& operator= (const NameTrie&) = default;
+
+  /**
+  * @brief default move operator
+  */
+  NameTrie& operator= (NameTrie&&) = default;
+
+  /**
+  * @brief default destructor
+  */
+  ~NameTrie() = default;
+
+  /**
+  * @brief method of adding the name into trie
+  * @param[in] name - name of operation
+  * @param[in] kind - kind of name
+  * @param[in] symbol - id of name in SymbolTable
+  */
+  void Insert(const std::string& name, Kind kind, uint32_t symbol);
+
+  /**
+  * @brief method of search the longest name which begins from position
+  * @param[in] text - text for search
+  * @param[in] pos - position in text to start search
+  * @param[out] kind - kind of found name, Kind::NONE if nothing is found
+  * @param[out] symbol - id of found name given by Insert
+  * @return length of found name, 0 if nothing is found
+  */
+  size_t Match(std::string_view text, size_t pos, Kind& kind, uint32_t& symbol) const;
+
+  /**
+  * @brief method of clearing trie
+  */
+  void Clear(void);
+private:
+  /**
+  * @brief number of characters which may be a part of name
+  */
+  static constexpr size_t ALPHABET = 128;
+
+  /**
+  * @brief trie's node
+  */
+  struct Node {
+    std::array<unsigned, ALPHABET> next = {};   ///< index of child node for every character, 0 if there is no child
+    Kind kind = Kind::NONE;                       ///< kind of name which ends in this node
+    uint32_t symbol = 0;                          ///< id of name which ends in this node
+  };
+
+  /**
+  * @brief trie's nodes, root has index 0
+  */
+  std::vector<Node> nodes;
+};
+
+
+
+
+/**
+* @brief singleton class of interned names
+* @details every name gets dense 32-bit id at the first call of Intern, ids are never reused or changed,
+* so id may be kept instead of name and used as index of flat arrays.
+* The class is thread safe, names are read by id without locking.
+*/
+class SymbolTable {
+public:
+  /**
+  * @brief id of name which is not interned
+  */
+  static constexpr uint32_t NONE = UINT32_MAX;
+
+  /**
+  * @brief copy consructor (deleted)
+  * @warning the method is deleted
+  */
+  SymbolTable(const SymbolTable&) = delete;
+
+  /**
+  * @brief move consructor (deleted)
+  * @warning the method is deleted
+  */
+  SymbolTable(SymbolTable&&) = delete;
+
+  /**
+  * @brief copy operator (deleted)
+  * @warning the operator is deleted
+  */
+  SymbolTable operator=(const SymbolTable&) = delete;
+
+  /**
+  * @brief move operator (deleted)
+  * @warning the operator is deleted
+  */
+  SymbolTable operator=(SymbolTable&&) = delete;
+
+  /**
+  * @brief default destructor
+  */
+  ~SymbolTable() = default;
+
+  /**
+  * @brief getter of exemplar of class
+  * @return exemplar of class
+  */
+  static SymbolTable& GetInstance(void);
+
+  /**
+  * @brief method of interning the name
+  * @param[in] name - name
+  * @return id of name, the same for equal names
+  * @throw std::exception if there are too many names
+  */
+  uint32_t Intern(std::string_view name);
+
+  /**
+  * @brief method of search id of name
+  * @param[in] name - name
+  * @return id of name, NONE if name is not interned
+  */
+  uint32_t Find(std::string_view name) const;
+
+  /**
+  * @brief getter of name
+  * @param[in] id - id returned by Intern
+  * @return name
+  */
+  const std::string& GetName(uint32_t id) const;
+
+  /**
+  * @brief getter of number of interned names
+  * @return number of names, all ids are less than it
+  */
+  uint32_t GetCount(void) const;
+private:
+  /**
+  * @brief number of names in one chunk of storage
+  */
+  static constexpr size_t CHUNK_SIZE = 4096;
+
+  /**
+  * @brief maximum number of chunks of storage
+  */
+  static constexpr size_t MAX_CHUNKS = 1024;
+
+  /**
+  * @brief default constructor
+  */
+  SymbolTable() = default;
+
+  /**
+  * @brief storage of names, chunks are never moved, so views of names and references to them stay valid
+  */
+  std::array<std::unique_ptr<std::string[]>, MAX_CHUNKS> chunks;
+
+  /**
+  * @brief ids of names, keys are views of storage
+  */
+  std::unordered_map<std::string_view, uint32_t> ids;
+
+  /**
+  * @brief number of names, it is increased after name is stored
+  */
+  std::atomic<uint32_t> count = 0;
+
+  /**
+  * @brief mutex of ids
+  */
+  mutable std::shared_mutex mutex;
+};
+
+
+
+
+/**
+* @brief struct of properties of operation which are read by parser
+* @details descriptors are built once, when snapshot is built, so parser reads plain fields instead of casting operations
+*/
+struct OperationDescriptor {
+  std::shared_ptr<Operation> operation;       ///< operation, nullptr if there is no operation
+  ElementType type = ElementType::FUNCTION;   ///< type of operation
+  uint32_t symbol = SymbolTable::NONE;        ///< id of name of operation
+  uint32_t pare = SymbolTable::NONE;          ///< id of name of pare open bracket for close bracket
+  int priority = 0;                           ///< priority of prefics and binary operators
+  bool rightAssociative = false;              ///< true for right associative binary operators
+  bool hasOperation = false;                  ///< true if operation is added into program when it is popped
+  bool pure = false;                          ///< result of Operation::IsPure
+  size_t argsNum = 0;                         ///< number of arguments
+  bool deferred = false;                      ///< true for stub of operation which module is not loaded yet
+};
+
+
+
+
+/**
+* @brief class of immutable set of operations
+* @details operations are kept in flat table indexed by id of name in SymbolTable, lookup by id is an array index,
+* the set is not changed after it is built, so any number of threads may read it without synchronization
+*/
+class OperationsSnapshot {
+public:
+  /**
+  * @brief struct of named operation
+  */
+  struct Entry {
+    std::string name;                       ///< name of operation
+    uint32_t symbol;                        ///< id of name in SymbolTable
+    std::shared_ptr<Operation> operation;   ///< operation
+    bool deferred = false;                  ///< true for stub of operation which module is not loaded yet
+  };
+
+  /**
+  * @brief constructor of empty set
+  */
+  OperationsSnapshot() : symbols(&SymbolTable::GetInstance()) {};
+
+  /**
+  * @brief constructor
+  * @param[in] functions - functions sorted by name
+  * @param[in] operators - operators sorted by name, several operators of different types may have the same name
+  * @param[in] brackets - brackets sorted by name
+  * @param[in] symbols - table which ids of entries are given by
+  * @param[in] generation - number of snapshot, it is increased by every change of set
+  */
+  OperationsSnapshot(std::vector<Entry> functions, std::vector<Entry> operators, std::vector<Entry> brackets,
+                     const SymbolTable& symbols, uint64_t generation);
+
+  /**
+  * @brief copy consructor (deleted)
+  * @warning the method is deleted
+  */
+  OperationsSnapshot(const OperationsSnapshot&) = delete;
+
+  /**
+  * @brief copy operator (deleted)
+  * @warning the operator is deleted
+  */
+  OperationsSnapshot& operator=(const OperationsSnapshot&) = delete;
+
+  /**
+  * @brief default destructor
+  */
+  ~OperationsSnapshot() = default;
+
+  /**
+  * @brief method of check availability of operation
+  * @param[in] name - name of operation
+  * @return true if there is operation, false otherwise
+  */
+  bool CheckOperation(std::string_view name) const;
+
+  /**
+  * @brief method of check availability of function
+  * @param[in] operation - name of function
+  * @return true if there is function, false otherwise
+  */
+  bool CheckFunction(std::string_view operation) const;
+
+  /**
+  * @brief method of check availability of operator
+  * @param[in] operation - name of operator
+  * @return true if there is operator, false otherwise
+  */
+  bool CheckOperator(std::string_view operation) const;
+
+  /**
+  * @brief method of check availability of bracket
+  * @param[in] operation - name of bracket
+  * @return true if there is bracket, false otherwise
+  */
+  bool CheckBracket(std::string_view operation) const;
+
+  /**
+  * @brief getter of function
+  * @param[in] operation - name of function
+  * @return shared pointer to function, nullptr if there is no function
+  */
+  std::shared_ptr<Operation> GetFunction(std::string_view operation) const;
+
+  /**
+  * @brief getter of bracket
+  * @param[in] operation - name of bracket
+  * @return shared pointer to bracket, nullptr if there is no bracket
+  */
+  std::shared_ptr<Operation> GetBracket(std::string_view operation) const;
+
+  /**
+  * @brief getter of operator
+  * @param[in] operation - name of operator
+  * @param[in] type - type of operator
+  * @return shared pointer to operator, nullptr if there is no operator
+  */
+  std::shared_ptr<Operation> GetOperator(std::string_view operation, ElementType type) const;
+
+  /**
+  * @brief method of check availability of bracket
+  * @param[in] symbol - id of name of bracket
+  * @return true if there is bracket, false otherwise
+  */
+  bool CheckBracket(uint32_t symbol) const;
+
+  /**
+  * @brief getter of function
+  * @param[in] symbol - id of name of function
+  * @return shared pointer to function, nullptr if there is no function
+  */
+  const std::shared_ptr<Operation>& GetFunction(uint32_t symbol) const;
+
+  /**
+  * @brief getter of bracket
+  * @param[in] symbol - id of name of bracket
+  * @return shared pointer to bracket, nullptr if there is no bracket
+  */
+  const std::shared_ptr<Operation>& GetBracket(uint32_t symbol) const;
+
+  /**
+  * @brief getter of operator
+  * @param[in] symbol - id of name of operator
+  * @param[in] type - type of operator
+  * @return shared pointer to operator, nullptr if there is no operator
+  */
+  const std::shared_ptr<Operation>& GetOperator(uint32_t symbol, ElementType type) const;
+
+  /**
+  * @brief getter of descriptor of operation
+  * @param[in] symbol - id of name of operation
+  * @param[in] type - type of operation
+  * @return descriptor, its operation is nullptr if there is no operation
+  */
+  const OperationDescriptor& GetDescriptor(uint32_t symbol, ElementType type) const;
+
+  /**
+  * @brief method of check that name belongs to stub of operation which module is not loaded yet
+  * @param[in] symbol - id of name
+  * @return true if any operation with this name is stub, false otherwise
+  */
+  bool IsDeferred(uint32_t symbol) const;
+
+  /**
+  * @brief method of search the longest operation's name in expression
+  * @param[in] expression - expression to search
+  * @param[in] pos - position in expression to start search
+  * @param[out] kind - kind of found name, NameTrie::Kind::NONE if nothing is found
+  * @param[out] symbol - id of found name in SymbolTable
+  * @return length of found name, 0 if nothing is found
+  */
+  size_t MatchName(std::string_view expression, size_t pos, NameTrie::Kind& kind, uint32_t& symbol) const;
+
+  /**
+  * @brief getter of functions
+  * @return functions sorted by name
+  */
+  const std::vector<Entry>& GetFunctions(void) const;
+
+  /**
+  * @brief getter of operators
+  * @return operators sorted by name
+  */
+  const std::vector<Entry>& GetOperators(void) const;
+
+  /**
+  * @brief getter of brackets
+  * @return brackets sorted by name
+  */
+  const std::vector<Entry>& GetBrackets(void) const;
+
+  /**
+  * @brief getter of number of snapshot
+  * @return number of snapshot, snapshots with different numbers may have different operations
+  */
+  uint64_t GetGeneration(void) const;
+private:
+  /**
+  * @brief number of types of operations, types from ElementType::PREFICS to ElementType::CLOSE_BRACKET
+  */
+  static constexpr size_t OPERATION_TYPES = size_t(ElementType::CLOSE_BRACKET) + 1;
+
+  /**
+  * @brief method of building descriptor of operation
+  * @param[in] operation - operation
+  * @param[in] symbol - id of name of operation
+  * @return descriptor
+  */
+  OperationDescriptor Describe(std::shared_ptr<Operation> operation, uint32_t symbol) const;
+
+  /**
+  * @brief method of adding entries into table and trie
+  * @param[in] entries - entries
+  * @param[in] kind - kind of names of entries
+  */
+  void Index(const std::vector<Entry>& entries, NameTrie::Kind kind);
+
+  /**
+  * @brief functions sorted by name
+  */
+  std::vector<Entry> functions;
+
+  /**
+  * @brief operators sorted by name
+  */
+  std::vector<Entry> operators;
+
+  /**
+  * @brief brackets sorted by name
+  */
+  std::vector<Entry> brackets;
+
+  /**
+  * @brief descriptors of operations, index is id of name, then type of operation
+  */
+  std::vector<std::array<OperationDescriptor, OPERATION_TYPES>> table;
+
+  /**
+  * @brief trie of all names
+  */
+  NameTrie names;
+
+  /**
+  * @brief table which ids of names are given by
+  */
+  const SymbolTable* symbols;
+
+  /**
+  * @brief number of snapshot
+  */
+  uint64_t generation = 0;
+};
+
+
+
 
 /**
 * @brief singletone class for storage operations
+* @details changes are made under lock and every change publishes a new immutable OperationsSnapshot through atomic pointer,
+* readers pin the current snapshot by GetSnapshot and read it without locking, pinned snapshot lives until the last reader releases it
 */
 class OperationsDescription {
 public:
@@ -42,21 +526,21 @@ public:
   * @param[in] name - name of function
   * @return true if name is valid, false otherwise
   */
-  static bool IsValidFunctionName(const std::string& name);
+  static bool IsValidFunctionName(std::string_view name);
 
   /**
   * @brief method of check validation operator's name
   * @param[in] name - name of operator
   * @return true if name is valid, false otherwise
   */
-  static bool IsValidOperatorName(const std::string& name);
+  static bool IsValidOperatorName(std::string_view name);
 
   /**
   * @brief method of check validation bracket's name
   * @param[in] name - name of bracket
   * @return true if name is valid, false otherwise
   */
-  static bool IsValidBracketName(const std::string& name);
+  static bool IsValidBracketName(std::string_view name);
   
   /**
   * @brief getter of exemplar of class
@@ -64,71 +548,131 @@ public:
   */
   static OperationsDescription& GetInstance(void);
 
+  /**
+  * @brief method of creating staging storage
+  * @details staging storage checks loaded operations like the main one but does not publish snapshots,
+  * its operations are moved into the main storage by Merge, so it may be filled by module in other thread
+  * @return staging storage
+  */
+  static std::unique_ptr<OperationsDescription> CreateStaging(void);
+
+  /**
+  * @brief getter of the current snapshot of operations
+  * @return snapshot, it is not changed by following loads
+  */
+  std::shared_ptr<const OperationsSnapshot> GetSnapshot(void) const;
+
   /**
   * @brief method of check availability of operation in internal storage
   * @param[in] name - name of operation
   * @return true if there is operation in internal storage, false otherwise
   */
-  bool CheckOperation(const std::string& name) const;
+  bool CheckOperation(std::string_view name) const;
 
   /**
   * @brief method of check availability of function in internal storage
   * @param[in] operation - name of function
   * @return true if there is function in internal storage, false otherwise
   */
-  bool CheckFunction(const std::string& operation) const;
+  bool CheckFunction(std::string_view operation) const;
  
   /**
   * @brief method of check availability of operator in internal storage
   * @param[in] operation - name of operator
   * @return true if there is operator in internal storage, false otherwise
   */
-  bool CheckOperator(const std::string& operation) const;
+  bool CheckOperator(std::string_view operation) const;
 
   /**
   * @brief method of check availability of bracket in internal storage
   * @param[in] operation - name of bracket
   * @return true if there is bracket in internal storage, false otherwise
   */
-  bool CheckBracket(const std::string& operation) const;
+  bool CheckBracket(std::string_view operation) const;
 
   /**
   * @brief getter of function from internal storage
   * @param[in] operation - name of function
   * @return shared pointer to function
   */
-  std::shared_ptr<Operation> GetFunction(const std::string& operation) const;
+  std::shared_ptr<Operation> GetFunction(std::string_view operation) const;
 
   /**
   * @brief getter of bracket from internal storage
   * @param[in] operation - name of bracket
   * @return shared pointer to bracket
   */
-  std::shared_ptr<Operation> GetBracket(const std::string& operation) const;
+  std::shared_ptr<Operation> GetBracket(std::string_view operation) const;
 
   /**
   * @brief getter of operator from internal storage
   * @param[in] operation - name of operator
   * @return shared pointer to operator
   */
-  std::shared_ptr<Operation> GetOperator(const std::string& operation, ElementType type) const;
+  std::shared_ptr<Operation> GetOperator(std::string_view operation, ElementType type) const;
+
+  /**
+  * @brief method of search the longest operation's name in expression
+  * @param[in] expression - expression to search
+  * @param[in] pos - position in expression to start search
+  * @param[out] kind - kind of found name, NameTrie::Kind::NONE if nothing is found
+  * @param[out] symbol - id of found name in SymbolTable
+  * @return length of found name, 0 if nothing is found
+  */
+  size_t MatchName(std::string_view expression, size_t pos, NameTrie::Kind& kind, uint32_t& symbol) const;
 
   /**
-  * @brief method of loading the operation into internal storage
+  * @brief getter of all operations of internal storage
+  * @details unlike snapshot, it is available for staging storage
+  * @return functions, operators and brackets sorted by name
+  */
+  std::vector<std::shared_ptr<Operation>> GetOperations(void);
+
+  /**
+  * @brief method of loading the operation into internal storage, publishes a new snapshot
   * @param[in] operation - shared pointer to operation, which you want to load
   */
   void LoadOperation(std::shared_ptr<Operation> operation);
 
   /**
-  * @brief method of clearing internal storage
+  * @brief method of loading operations of staging storages, publishes one snapshot
+  * @details storages are merged in order, staging storage with operation which can not be loaded is skipped entirely
+  * @param[in] stagings - staging storages
+  * @throw std::exception with the first error after the rest storages are merged and snapshot is published
+  */
+  void Merge(const std::vector<const OperationsDescription*>& stagings);
+
+  /**
+  * @brief method of loading stubs of operations which are loaded on the first use, publishes a new snapshot
+  * @details stubs are checked like other operations, they give names to separator while their module is not loaded,
+  * the first Resolve of any of their names calls loader and replaces all stubs by loaded operations
+  * @param[in] stubs - stubs of operations
+  * @param[in] loader - function which returns staging storage with loaded operations, see CreateStaging,
+  * it must load operation of the same type, name, priority and number of arguments for every stub and nothing else
+  * @throw std::exception if any stub can not be loaded, no stub is loaded then
+  */
+  void Defer(const std::vector<std::shared_ptr<Operation>>& stubs, std::function<std::unique_ptr<OperationsDescription>(void)> loader);
+
+  /**
+  * @brief method of loading operations deferred by Defer, publishes a new snapshot
+  * @details loading of the same stubs by concurrent calls is done once, other calls wait for it
+  * @param[in] symbol - id of name of any stub
+  * @return true if stubs are replaced by loaded operations, false if there is no stub with this name
+  * @throw std::exception if loader throws or loaded operations do not match stubs, stubs are kept and the error is thrown by following calls
+  */
+  bool Resolve(uint32_t symbol);
+
+  /**
+  * @brief method of clearing internal storage, publishes an empty snapshot
   * @warning make sure to call this method at the end of the program
   */
   void Clear(void);
 private:
   /**
-  * @brief default constructor
+  * @brief constructor
+  * @details symbol table is bound here, in the program, because modules which call LoadOperation have their own copy of it
   */
-  OperationsDescription() = default;
+  OperationsDescription() : symbols(SymbolTable::GetInstance()) {};
 
   /**
   * @brief method for checking the first character of a function name for validity
@@ -172,20 +716,90 @@ private:
   */
   void AddBracket(std::shared_ptr<Operation> operation);
 
+  /**
+  * @brief getter of operator from internal storage
+  * @param[in] operation - name of operator
+  * @param[in] type - type of operator
+  * @return shared pointer to operator, nullptr if there is no operator
+  */
+  std::shared_ptr<Operation> FindOperator(std::string_view operation, ElementType type) const;
+
+  /**
+  * @brief method of publishing snapshot of internal storage
+  * @warning the method must be called under writeMutex
+  */
+  void Publish(void);
+
+  /**
+  * @brief method of removing the operation from internal storage without publishing
+  * @param[in] operation - operation
+  * @warning the method must be called under writeMutex
+  */
+  void Remove(const std::shared_ptr<Operation>& operation);
+
+  /**
+  * @brief struct of stubs which are loaded together
+  */
+  struct Deferred {
+    std::vector<std::shared_ptr<Operation>> stubs;                        ///< stubs of operations
+    std::function<std::unique_ptr<OperationsDescription>(void)> loader;   ///< function of loading operations
+    std::mutex loadMutex;                                                 ///< guard of loading against concurrent calls of Resolve
+    bool loaded = false;                                                  ///< true if stubs are replaced by loaded operations
+    std::string error;                                                    ///< error of loading, empty if there is no error
+  };
+
   /**
   * @brief function's internal storage
   */
-  std::map<std::string, std::shared_ptr<Operation>> functions;
+  std::map<std::string, std::shared_ptr<Operation>, std::less<>> functions;
 
   /**
   * @brief operators's internal storage
   */
-  std::multimap<std::string, std::shared_ptr<Operation>> operators;
+  std::multimap<std::string, std::shared_ptr<Operation>, std::less<>> operators;
 
   /**
   * @brief brackets's internal storage
   */
-  std::map<std::string, std::shared_ptr<Operation>> brackets;
+  std::map<std::string, std::shared_ptr<Operation>, std::less<>> brackets;
+
+  /**
+  * @brief method of loading the operation into internal storage without publishing
+  * @param[in] operation - shared pointer to operation
+  * @return true if operation is loaded, false if it is not an operator, function or bracket
+  * @warning the method must be called under writeMutex
+  */
+  bool Add(std::shared_ptr<Operation> operation);
+
+  /**
+  * @brief table which ids of names are given by
+  */
+  SymbolTable& symbols;
+
+  /**
+  * @brief true for staging storage, which does not publish snapshots
+  */
+  bool staging = false;
+
+  /**
+  * @brief groups of stubs by their operations
+  */
+  std::unordered_map<const Operation*, std::shared_ptr<Deferred>> deferred;
+
+  /**
+  * @brief guard of internal storage against concurrent changes
+  */
+  std::mutex writeMutex;
+
+  /**
+  * @brief number of the last published snapshot
+  */
+  uint64_t generation = 0;
+
+  /**
+  * @brief the current snapshot, it is accessed only through std::atomic_load and std::atomic_store
+  */
+  std::shared_ptr<const OperationsSnapshot> snapshot = std::make_shared<const OperationsSnapshot>();
 };
 
 
@@ -209,6 +823,11 @@ public:
   */
   using DoBinaryOperation = std::shared_ptr<Literal>(*)(std::shared_ptr<Operand> a, std::shared_ptr<Operand> b);
 
+  /**
+  * @brief an internal type for storing a function that performs a specific operation on values of data stack
+  */
+  using DoValueBinaryOperation = double(*)(const Value& a, const Value& b);
+
   /**
   * @brief default consructor (deleted)
   * @warning the method is deleted
@@ -221,9 +840,21 @@ public:
   * @param[in] prioryty - operation priority
   * @param[in] operation - function that performs a specific operation
   * @param[in] associative - operator associativity
+  * @param[in] pure - true if operation has no side effects, false by default since operands may be changed through shared pointer
+  */
+  BinaryOperator(const std::string& name, int prioryty, DoBinaryOperation operation, Associative associative = Associative::LEFT, bool pure = false) :
+    name(name), prioryty(prioryty), doOperation(operation), doValueOperation(nullptr), assotiative(associative), pure(pure) {};
+
+  /**
+  * @brief constructor
+  * @param[in] name - the string by which the operator in the expression is recognized
+  * @param[in] prioryty - operation priority
+  * @param[in] operation - function that performs a specific operation on values
+  * @param[in] associative - operator associativity
+  * @param[in] pure - true if operation has no side effects and its result depends only on arguments
   */
-  BinaryOperator(const std::string& name, int prioryty, DoBinaryOperation operation, Associative associative = Associative::LEFT) :
-    name(name), prioryty(prioryty), doOperation(operation), assotiative(associative) {};
+  BinaryOperator(const std::string& name, int prioryty, DoValueBinaryOperation operation, Associative associative = Associative::LEFT, bool pure = true) :
+    name(name), prioryty(prioryty), doOperation(nullptr), doValueOperation(operation), assotiative(associative), pure(pure) {};
 
   /**
   * @brief default copy constructor
@@ -264,6 +895,12 @@ public:
   */
   Associative GetAssociative(void) const;
 
+  /**
+  * @brief getter of function performing operation on values
+  * @return function or nullptr if operator is registered with shared pointer signature
+  */
+  DoValueBinaryOperation GetValueOperation(void) const;
+
   /**
   * @brief getter of operation's type
   * @return ElementType::BINARY
@@ -276,6 +913,12 @@ public:
   */
   std::string GetTokenName(void) const override final;
 
+  /**
+  * @brief method of check purity of operation
+  * @return true if operation has no side effects and its result depends only on arguments, false otherwise
+  */
+  bool IsPure(void) const override final;
+
   /**
   * @brief method performing this operation interacting with the data stack
   * @param[in/out] dataStack - data stack, the result goes back to the top
@@ -287,6 +930,11 @@ private:
   */
   DoBinaryOperation doOperation;
 
+  /**
+  * @brief function that performs a specific operation on values
+  */
+  DoValueBinaryOperation doValueOperation;
+
   /**
   * @brief the string by which the operator in the expression is recognized
   */
@@ -301,6 +949,11 @@ private:
   * @brief operator associativity
   */
   const Associative assotiative;
+
+  /**
+  * @brief true if operation has no side effects and its result depends only on arguments
+  */
+  const bool pure;
 };
 
 
@@ -316,6 +969,11 @@ public:
   */
   using DoPreficsOperation = std::shared_ptr<Literal>(*)(std::shared_ptr<Operand> a);
 
+  /**
+  * @brief an internal type for storing a function that performs a specific operation on value of data stack
+  */
+  using DoValuePreficsOperation = double(*)(const Value& a);
+
   /**
   * @brief default consructor (deleted)
   * @warning the method is deleted
@@ -327,9 +985,20 @@ public:
   * @param[in] name - the string by which the operator in the expression is recognized
   * @param[in] prioryty - operation priority, affects interaction with binary operators
   * @param[in] operation - function that performs a specific operation
+  * @param[in] pure - true if operation has no side effects, false by default since operands may be changed through shared pointer
+  */
+  PreficsOperator(const std::string& name, int prioryty, DoPreficsOperation operation, bool pure = false) :
+    name(name), prioryty(prioryty), doOperation(operation), doValueOperation(nullptr), pure(pure) {};
+
+  /**
+  * @brief constructor
+  * @param[in] name - the string by which the operator in the expression is recognized
+  * @param[in] prioryty - operation priority, affects interaction with binary operators
+  * @param[in] operation - function that performs a specific operation on value
+  * @param[in] pure - true if operation has no side effects and its result depends only on arguments
   */
-  PreficsOperator(const std::string& name, int prioryty, DoPreficsOperation operation) :
-    name(name), prioryty(prioryty), doOperation(operation) {};
+  PreficsOperator(const std::string& name, int prioryty, DoValuePreficsOperation operation, bool pure = true) :
+    name(name), prioryty(prioryty), doOperation(nullptr), doValueOperation(operation), pure(pure) {};
 
   /**
   * @brief default copy constructor
@@ -362,6 +1031,12 @@ public:
   */
   int GetPriority(void) const;
 
+  /**
+  * @brief getter of function performing operation on value
+  * @return function or nullptr if operator is registered with shared pointer signature
+  */
+  DoValuePreficsOperation GetValueOperation(void) const;
+
   /**
   * @brief getter of operation's type
   * @return ElementType::PREFICS
@@ -374,6 +1049,12 @@ public:
   */
   std::string GetTokenName(void) const override final;
 
+  /**
+  * @brief method of check purity of operation
+  * @return true if operation has no side effects and its result depends only on arguments, false otherwise
+  */
+  bool IsPure(void) const override final;
+
   /**
   * @brief method performing this operation interacting with the data stack
   * @param[in/out] dataStack - data stack, the result goes back to the top
@@ -385,6 +1066,11 @@ private:
   */
   DoPreficsOperation doOperation;
 
+  /**
+  * @brief function that performs a specific operation on value
+  */
+  DoValuePreficsOperation doValueOperation;
+
   /**
   * @brief the string by which the operator in the expression is recognized
   */
@@ -394,6 +1080,11 @@ private:
   * @brief operation priority
   */
   const int prioryty;
+
+  /**
+  * @brief true if operation has no side effects and its result depends only on arguments
+  */
+  const bool pure;
 };
 
 
@@ -408,6 +1099,11 @@ public:
   * @brief an internal type for storing a function that performs a specific operation
   */
   using DoPostficsOperation = std::shared_ptr<Literal>(*)(std::shared_ptr<Operand> a);
+
+  /**
+  * @brief an internal type for storing a function that performs a specific operation on value of data stack
+  */
+  using DoValuePostficsOperation = double(*)(const Value& a);
   
   /**
   * @brief default consructor (deleted)
@@ -419,9 +1115,19 @@ public:
   * @brief constructor
   * @param[in] name - the string by which the operator in the expression is recognized
   * @param[in] operation - function that performs a specific operation
+  * @param[in] pure - true if operation has no side effects, false by default since operands may be changed through shared pointer
   */
-  PostficsOperator(const std::string& name, DoPostficsOperation operation) :
-    name(name), doOperation(operation) {};
+  PostficsOperator(const std::string& name, DoPostficsOperation operation, bool pure = false) :
+    name(name), doOperation(operation), doValueOperation(nullptr), pure(pure) {};
+
+  /**
+  * @brief constructor
+  * @param[in] name - the string by which the operator in the expression is recognized
+  * @param[in] operation - function that performs a specific operation on value
+  * @param[in] pure - true if operation has no side effects and its result depends only on arguments
+  */
+  PostficsOperator(const std::string& name, DoValuePostficsOperation operation, bool pure = true) :
+    name(name), doOperation(nullptr), doValueOperation(operation), pure(pure) {};
   
   /**
   * @brief default copy constructor
@@ -448,6 +1154,12 @@ public:
   */
   ~PostficsOperator() = default;
 
+  /**
+  * @brief getter of function performing operation on value
+  * @return function or nullptr if operator is registered with shared pointer signature
+  */
+  DoValuePostficsOperation GetValueOperation(void) const;
+
   /**
   * @brief getter of operation's type
   * @return ElementType::POSTFICS
@@ -460,6 +1172,12 @@ public:
   */
   std::string GetTokenName(void) const override final;
 
+  /**
+  * @brief method of check purity of operation
+  * @return true if operation has no side effects and its result depends only on arguments, false otherwise
+  */
+  bool IsPure(void) const override final;
+
   /**
   * @brief method performing this operation interacting with the data stack
   * @param[in/out] dataStack - data stack, the result goes back to the top
@@ -471,10 +1189,20 @@ private:
   */
   DoPostficsOperation doOperation;
 
+  /**
+  * @brief function that performs a specific operation on value
+  */
+  DoValuePostficsOperation doValueOperation;
+
   /**
   * @brief the string by which the operator in the expression is recognized
   */
   const std::string name;
+
+  /**
+  * @brief true if operation has no side effects and its result depends only on arguments
+  */
+  const bool pure;
 };
 
 
@@ -489,6 +1217,11 @@ public:
   * @brief an internal type for storing a function that performs a specific operation
   */
   using DoFunc = std::shared_ptr<Literal>(*)(std::shared_ptr<Operand> a);
+
+  /**
+  * @brief an internal type for storing a function that performs a specific operation on value of data stack
+  */
+  using DoValueFunc = double(*)(const Value& a);
   
   /**
   * @brief default consructor (deleted)
@@ -500,9 +1233,26 @@ public:
   * @brief constructor
   * @param[in] name - the string by which the bracket in the expression is recognized
   * @param[in] operation - function that performs a specific operation
+  * @param[in] pure - true if operation has no side effects, false by default since operands may be changed through shared pointer
   */
-  OpenBracket(const std::string& name, DoFunc operation) :
-    name(name), doOperation(operation) {};
+  OpenBracket(const std::string& name, DoFunc operation, bool pure = false) :
+    name(name), doOperation(operation), doValueOperation(nullptr), pure(pure) {};
+
+  /**
+  * @brief constructor
+  * @param[in] name - the string by which the bracket in the expression is recognized
+  * @param[in] operation - function that performs a specific operation on value
+  * @param[in] pure - true if operation has no side effects and its result depends only on arguments
+  */
+  OpenBracket(const std::string& name, DoValueFunc operation, bool pure = true) :
+    name(name), doOperation(nullptr), doValueOperation(operation), pure(pure) {};
+
+  /**
+  * @brief constructor of bracket without operation
+  * @param[in] name - the string by which the bracket in the expression is recognized
+  */
+  OpenBracket(const std::string& name, std::nullptr_t) :
+    name(name), doOperation(nullptr), doValueOperation(nullptr), pure(true) {};
 
   /**
   * @brief default copy constructor
@@ -529,6 +1279,18 @@ public:
   */
   ~OpenBracket() = default;
 
+  /**
+  * @brief getter of function performing operation on value
+  * @return function or nullptr if bracket has no operation or it is registered with shared pointer signature
+  */
+  DoValueFunc GetValueOperation(void) const;
+
+  /**
+  * @brief method of check availability of operation
+  * @return true if bracket performs some operation, false otherwise
+  */
+  bool HasOperation(void) const;
+
   /**
   * @brief getter of operation's type
   * @return ElementType::OPEN_BRACKET
@@ -541,6 +1303,12 @@ public:
   */
   std::string GetTokenName(void) const override final;
 
+  /**
+  * @brief method of check purity of operation
+  * @return true if operation has no side effects and its result depends only on arguments, false otherwise
+  */
+  bool IsPure(void) const override final;
+
   /**
   * @brief method performing this operation interacting with the data stack
   * @param[in/out] dataStack - data stack, the result goes back to the top
@@ -552,10 +1320,20 @@ private:
   */
   DoFunc doOperation;
 
+  /**
+  * @brief function that performs a specific operation on value
+  */
+  DoValueFunc doValueOperation;
+
   /**
   * @brief the string by which the operator in the expression is recognized
   */
   const std::string name;
+
+  /**
+  * @brief true if operation has no side effects and its result depends only on arguments
+  */
+  const bool pure;
 };
 
 
@@ -623,6 +1401,12 @@ public:
   */
   ElementType GetType(void) const override final;
 
+  /**
+  * @brief method of check purity of operation
+  * @return true if operation has no side effects and its result depends only on arguments, false otherwise
+  */
+  bool IsPure(void) const override final;
+
   /**
   * @brief method performing this operation interacting with the data stack
   * @param[in/out] dataStack - data stack, the result goes back to the top
@@ -654,6 +1438,22 @@ public:
   */
   using DoFunc = std::shared_ptr<Literal>(*)(std::vector<std::shared_ptr<Operand>> args);
 
+  /**
+  * @brief an internal type for storing a function of any number of arguments
+  * @details args points to argsNum values in order of passing
+  */
+  using DoSpanFunc = double(*)(const double* args, size_t argsNum);
+
+  /**
+  * @brief an internal type for storing a function of one argument
+  */
+  using DoUnaryFunc = double(*)(double a);
+
+  /**
+  * @brief an internal type for storing a function of two arguments
+  */
+  using DoBinaryFunc = double(*)(double a, double b);
+
   /**
   * @brief default consructor (deleted)
   * @warning the method is deleted
@@ -665,9 +1465,38 @@ public:
   * @param[in] name - the string by which the function in the expression is recognized
   * @param[in] argsNum - the number of arguments this function works with
   * @param[in] operation - function that performs a specific operation
+  * @param[in] pure - true if operation has no side effects, false by default since operands may be changed through shared pointer
   */
-  Function(std::string name, int argsNum, DoFunc operation) :
-    name(name), argsNum(argsNum), doOperation(operation) {};
+  Function(std::string name, int argsNum, DoFunc operation, bool pure = false) :
+    name(name), argsNum(argsNum), doOperation(operation), doSpanOperation(nullptr), doUnaryOperation(nullptr), doBinaryOperation(nullptr), pure(pure) {};
+
+  /**
+  * @brief constructor
+  * @param[in] name - the string by which the function in the expression is recognized
+  * @param[in] argsNum - the number of arguments this function works with
+  * @param[in] operation - function that performs a specific operation on array of arguments
+  * @param[in] pure - true if operation has no side effects and its result depends only on arguments
+  */
+  Function(std::string name, int argsNum, DoSpanFunc operation, bool pure = true) :
+    name(name), argsNum(argsNum), doOperation(nullptr), doSpanOperation(operation), doUnaryOperation(nullptr), doBinaryOperation(nullptr), pure(pure) {};
+
+  /**
+  * @brief constructor of function of one argument
+  * @param[in] name - the string by which the function in the expression is recognized
+  * @param[in] operation - function that performs a specific operation
+  * @param[in] pure - true if operation has no side effects and its result depends only on arguments
+  */
+  Function(std::string name, DoUnaryFunc operation, bool pure = true) :
+    name(name), argsNum(1), doOperation(nullptr), doSpanOperation(nullptr), doUnaryOperation(operation), doBinaryOperation(nullptr), pure(pure) {};
+
+  /**
+  * @brief constructor of function of two arguments
+  * @param[in] name - the string by which the function in the expression is recognized
+  * @param[in] operation - function that performs a specific operation
+  * @param[in] pure - true if operation has no side effects and its result depends only on arguments
+  */
+  Function(std::string name, DoBinaryFunc operation, bool pure = true) :
+    name(name), argsNum(2), doOperation(nullptr), doSpanOperation(nullptr), doUnaryOperation(nullptr), doBinaryOperation(operation), pure(pure) {};
 
   /**
   * @brief default copy constructor
@@ -694,6 +1523,30 @@ public:
   */
   ~Function() = default;
 
+  /**
+  * @brief getter of the number of arguments
+  * @return the number of arguments this function works with
+  */
+  int GetArgsNum(void) const;
+
+  /**
+  * @brief getter of function of any number of arguments
+  * @return function or nullptr if function is registered with other signature
+  */
+  DoSpanFunc GetSpanOperation(void) const;
+
+  /**
+  * @brief getter of function of one argument
+  * @return function or nullptr if function is registered with other signature
+  */
+  DoUnaryFunc GetUnaryOperation(void) const;
+
+  /**
+  * @brief getter of function of two arguments
+  * @return function or nullptr if function is registered with other signature
+  */
+  DoBinaryFunc GetBinaryOperation(void) const;
+
   /**
   * @brief getter of function's name
   * @return the string by which the function in the expression is recognized
@@ -706,6 +1559,12 @@ public:
   */
   ElementType GetType(void) const override final;
 
+  /**
+  * @brief method of check purity of operation
+  * @return true if operation has no side effects and its result depends only on arguments, false otherwise
+  */
+  bool IsPure(void) const override final;
+
   /**
   * @brief method performing this operation interacting with the data stack
   * @param[in/out] dataStack - data stack, the result goes back to the top
@@ -717,6 +1576,26 @@ private:
   */
   DoFunc doOperation;
 
+  /**
+  * @brief function that performs a specific operation on array of arguments
+  */
+  DoSpanFunc doSpanOperation;
+
+  /**
+  * @brief function of one argument
+  */
+  DoUnaryFunc doUnaryOperation;
+
+  /**
+  * @brief function of two arguments
+  */
+  DoBinaryFunc doBinaryOperation;
+
+  /**
+  * @brief the number of arguments passed to DoSpanFunc without heap allocation
+  */
+  static constexpr int LOCAL_ARGS_NUM = 16;
+
   /**
   * @brief the string by which the function in the expression is recognized
   */
@@ -726,4 +1605,9 @@ private:
   * @brief the number of arguments this function works with
   */
   const int argsNum;
+
+  /**
+  * @brief true if operation has no side effects and its result depends only on arguments
+  */
+  const bool pure;
 };
\ No newline at end of file
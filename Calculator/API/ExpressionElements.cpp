@@ -23,7 +23,7 @@ bool Variable::IsValidValueName(const std::string& name) {
 
 double Variable::GetValue(void) const{
   if (isInit != true)
-    throw std::exception(("Variable " + name + " not init").c_str());
+    throw std::runtime_error(("Variable " + name + " not init").c_str());
   return value;
 }
 
@@ -42,4 +42,16 @@ bool Variable::IsInit(void) const {
 void Variable::SetValue(const double value) {
   this->value = value;
   isInit = true;
-};
\ No newline at end of file
+};
+
+void Value::SetValue(const double value) const {
+  if (variable == nullptr)
+    throw std::runtime_error("Impossible to assign a value to a non-variable");
+  variable->SetValue(value);
+}
+
+std::shared_ptr<Operand> Value::ToOperand(void) const {
+  if (variable == nullptr)
+    return std::make_shared<Literal>(number);
+  return std::shared_ptr<Variable>(std::shared_ptr<Variable>(), variable);
+}
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <map>
 #include <memory>
 #include <exception>
+#include <stdexcept>
 
 /**
 * @brief argument separator in function call
@@ -234,6 +235,200 @@ private:
 
 
 
+/**
+* @brief class of small tagged value on the data stack: number or reference to variable
+*/
+class Value {
+public:
+  /**
+  * @brief constructor of zero number
+  */
+  Value() : number(0), variable(nullptr) {};
+
+  /**
+  * @brief constructor of number
+  * @param[in] number - value
+  */
+  Value(double number) : number(number), variable(nullptr) {};
+
+  /**
+  * @brief constructor of reference to variable
+  * @param[in] variable - pointer to variable, value does not own it
+  */
+  explicit Value(Variable* variable) : number(0), variable(variable) {};
+
+  /**
+  * @brief default copy constructor
+  */
+  Value(const Value&) = default;
+
+  /**
+  * @brief default copy operator
+  */
+  Value& operator=(const Value&) = default;
+
+  /**
+  * @brief default destructor
+  */
+  ~Value() = default;
+
+  /**
+  * @brief getter of value
+  * @return number or value of referenced variable
+  * @throw std::exception if referenced variable is not init
+  */
+  double GetValue(void) const {
+    return variable == nullptr ? number : variable->GetValue();
+  };
+
+  /**
+  * @brief getter of value's type
+  * @return ElementType::VARIABLE if value refers to variable, ElementType::LITERAL otherwise
+  */
+  ElementType GetType(void) const {
+    return variable == nullptr ? ElementType::LITERAL : ElementType::VARIABLE;
+  };
+
+  /**
+  * @brief setter value of referenced variable
+  * @param[in] value - new value of variable
+  * @throw std::exception if value does not refer to variable
+  */
+  void SetValue(const double value) const;
+
+  /**
+  * @brief method of converting to operand for operations with shared pointer signature
+  * @return literal with value or non-owning pointer to referenced variable
+  */
+  std::shared_ptr<Operand> ToOperand(void) const;
+private:
+  /**
+  * @brief number, used if value does not refer to variable
+  */
+  double number;
+
+  /**
+  * @brief referenced variable, nullptr for number
+  */
+  Variable* variable;
+};
+
+
+
+
+/**
+* @brief class of contiguous data stack of values over external storage
+*/
+class ValueStack {
+public:
+  /**
+  * @brief default consructor (deleted)
+  * @warning the method is deleted
+  */
+  ValueStack() = delete;
+
+  /**
+  * @brief constructor
+  * @param[in] data - storage for values, stack does not own it
+  * @param[in] capacity - size of storage
+  */
+  ValueStack(Value* data, size_t capacity) : data(data), capacity(capacity), count(0) {};
+
+  /**
+  * @brief constructor over storage which already contains values
+  * @param[in] data - storage for values, stack does not own it
+  * @param[in] capacity - size of storage
+  * @param[in] size - number of values already on stack
+  */
+  ValueStack(Value* data, size_t capacity, size_t size) : data(data), capacity(capacity), count(size) {};
+
+  /**
+  * @brief copy consructor (deleted)
+  * @warning the method is deleted
+  */
+  ValueStack(const ValueStack&) = delete;
+
+  /**
+  * @brief copy operator (deleted)
+  * @warning the operator is deleted
+  */
+  ValueStack& operator=(const ValueStack&) = delete;
+
+  /**
+  * @brief default destructor
+  */
+  ~ValueStack() = default;
+
+  /**
+  * @brief getter of number of values on stack
+  * @return number of values
+  */
+  size_t size(void) const {
+    return count;
+  };
+
+  /**
+  * @brief method of check emptiness of stack
+  * @return true if stack is empty, false otherwise
+  */
+  bool empty(void) const {
+    return count == 0;
+  };
+
+  /**
+  * @brief getter of top value
+  * @return reference to top value
+  */
+  Value& top(void) {
+    return data[count - 1];
+  };
+
+  /**
+  * @brief method of removing top value
+  */
+  void pop(void) {
+    count--;
+  };
+
+  /**
+  * @brief method of adding value to top
+  * @param[in] value - value to add
+  * @throw std::exception if storage is full
+  */
+  void push(const Value& value) {
+    if (count == capacity)
+      throw std::runtime_error("Data stack overflow");
+    data[count++] = value;
+  };
+
+  /**
+  * @brief getter of several top values
+  * @param[in] num - number of values
+  * @return pointer to the deepest of num top values, values go in order of pushing
+  */
+  Value* last(size_t num) {
+    return data + count - num;
+  };
+private:
+  /**
+  * @brief storage for values
+  */
+  Value* data;
+
+  /**
+  * @brief size of storage
+  */
+  size_t capacity;
+
+  /**
+  * @brief number of values on stack
+  */
+  size_t count;
+};
+
+
+
+
 /**
 * @brief base class for operation
 */
@@ -242,7 +437,14 @@ public:
   /**
   * @brief internal type for naming the stack of operations
   */
-  using DataStack = std::stack<std::shared_ptr<Operand>>;
+  using DataStack = ValueStack;
+
+  /**
+  * @brief signature of batch kernel of operation
+  * @details kernel computes operation for n rows, argument i of row r is args[i][r], result of row r is out[r],
+  * out may be equal to any of arguments
+  */
+  using BatchKernel = void(*)(const double* const* args, double* out, size_t n);
 
   /**
   * @brief getter of operation's name
@@ -256,6 +458,13 @@ public:
   */
   virtual ElementType GetType(void) const = 0;
 
+  /**
+  * @brief method of check purity of operation
+  * @details pure operations with constant arguments may be computed once at compile time
+  * @return true if operation has no side effects and its result depends only on arguments, false otherwise
+  */
+  virtual bool IsPure(void) const = 0;
+
   /**
   * @brief virtual default destructor
   */
@@ -266,4 +475,26 @@ public:
   * @param[in/out] dataStack - data stack, the result goes back to the top
   */
   virtual void DoOperation(DataStack& dataStack) const = 0;
+
+  /**
+  * @brief setter of batch kernel
+  * @details kernel is preferred to value operation when blocks of rows are evaluated, it must compute the same function
+  * @param[in] kernel - batch kernel, nullptr if rows are evaluated one at a time
+  */
+  void SetBatchOperation(BatchKernel kernel) {
+    batchOperation = kernel;
+  }
+
+  /**
+  * @brief getter of batch kernel
+  * @return batch kernel, nullptr if there is no kernel
+  */
+  BatchKernel GetBatchOperation(void) const {
+    return batchOperation;
+  }
+private:
+  /**
+  * @brief batch kernel, nullptr if there is no kernel
+  */
+  BatchKernel batchOperation = nullptr;
 };
\ No newline at end of file
@@ -1,10 +1,94 @@
 #pragma once
 
-#include "..\ModuleManager\ModuleManager.h"
-#include "..\API\API.h"
+#include "../ModuleManager/ModuleManager.h"
+#include "../API/API.h"
+
+/**
+* @brief addition function
+* @param[in] a - first term
+* @param[in] b - second term
+* @return the result of the addition
+*/
+double Add(const Value& a, const Value& b);
+
+/**
+* @brief subtraction function
+* @param[in] a - minuend
+* @param[in] b - subtrahend
+* @return the result of the subtraction
+*/
+double Sub(const Value& a, const Value& b);
+
+/**
+* @brief multiplication function
+* @param[in] a - first factor
+* @param[in] b - second factor
+* @return the result of the multiplication
+*/
+double Mul(const Value& a, const Value& b);
+
+/**
+* @brief division function
+* @param[in] a - dividend
+* @param[in] b - divider
+* @return the result of the division
+*/
+double Div(const Value& a, const Value& b);
+
+/**
+* @brief value assignment function
+* @param[in] a - variable for setting value
+* @param[in] b - operand for getting value
+* @return the assigned value
+*/
+double Assign(const Value& a, const Value& b);
+
+/**
+* @brief unary minus function
+* @param[in] a - variable for sign change
+* @return the result of operation
+*/
+double UnaryMinus(const Value& a);
+
+/**
+* @brief prefics increment function for variable
+* @param[in] a - variable
+* @return new value of variable
+*/
+double PrefixIncrement(const Value& a);
+
+/**
+* @brief prefics decrement function for variable
+* @param[in] a - variable
+* @return new value of variable
+*/
+double PrefixDecrement(const Value& a);
+
+/**
+* @brief postfics increment function for variable
+* @param[in] a - variable
+* @return value of variable before operation
+*/
+double PostfixIncrement(const Value& a);
+
+/**
+* @brief postfics decrement function for variable
+* @param[in] a - variable
+* @return value of variable before operation
+*/
+double PostfixDecrement(const Value& a);
+
+/**
+* @brief function of maximum for 2 argumets
+* @param[in] a - first argument
+* @param[in] b - second argument
+* @return maximum of two argument
+*/
+double Max(double a, double b);
 
 /**
 * @brief function of loading basic operations into storage
+* @details operations are collected in staging storage and merged at once, so one snapshot is published
 * @param[in/out] dstr - singleton storage operations
 */
 void LoadBase(OperationsDescription& dstr);
\ No newline at end of file
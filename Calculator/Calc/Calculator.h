@@ -1,12 +1,126 @@
 #pragma once
 
 #include "../API/API.h"
-#include "../Separator/Separator.h"
+#include "../CompileCache/CompileCache.h"
+#include <deque>
 
 /**
-* @brief singleton class for managing global variables
+* @brief class of variables which expressions are evaluated with
+* @details variables are kept in flat array indexed by id of their names in SymbolTable, so binding of compiled expression
+* is an array lookup per slot, and evaluation works with variables of context directly without copying them.
+* Independent contexts may be used by different threads at the same time without locking.
+* @warning the class is not thread safe, one context must not be used by several threads at the same time
 */
-class VariableManager {
+class EvaluationContext {
+public:
+  /**
+  * @brief default constructor, context has no variables
+  */
+  EvaluationContext() = default;
+
+  /**
+  * @brief default copy constructor
+  */
+  EvaluationContext(const EvaluationContext&) = default;
+
+  /**
+  * @brief default move constructor
+  */
+  EvaluationContext(EvaluationContext&&) = default;
+
+  /**
+  * @brief default copy operator
+  */
+  EvaluationContext& operator= (const EvaluationContext&) = default;
+
+  /**
+  * @brief default move operator
+  */
+  EvaluationContext& operator= (EvaluationContext&&) = default;
+
+  /**
+  * @brief default destructor
+  */
+  ~EvaluationContext() = default;
+
+  /**
+  * @brief method of check availability of init variable in context
+  * @param[in] name - name of variable
+  * @return true if there is init variable in context, false otherwise
+  */
+  bool CheckVariable(const std::string& name) const;
+
+  /**
+  * @brief method of loading the variable into context
+  * @param[in] var - variable, which you want to load
+  * @throw std::exception if name of variable is not valid or it is name of operation
+  */
+  void AddVariable(Variable var);
+
+  /**
+  * @brief getter of init variable from context
+  * @param[in] name - name of variable
+  * @return variable
+  * @throw std::exception if there is no init variable
+  */
+  Variable FindVariable(const std::string& name) const;
+
+  /**
+  * @brief method of evaluating compiled expression with variables of context
+  * @details assignments are made in variables of context, ones made before error are kept
+  * @param[in] expression - compiled expression
+  * @return result of evaluating
+  */
+  double Evaluate(const CompiledExpression& expression);
+
+  /**
+  * @brief method of evaluating tiered expression with variables of context
+  * @details expression is run by machine code once it is hot, see TieredExpression
+  * @param[in/out] expression - tiered compiled expression
+  * @return result of evaluating
+  */
+  double Evaluate(TieredExpression& expression);
+
+  /**
+  * @brief method of calculating expression with variables of context
+  * @details compiled expression is taken from CompileCache
+  * @param[in] expression - expression for calculating
+  * @return result of calculating
+  */
+  double Calculate(const std::string& expression);
+private:
+  /**
+  * @brief getter of variable, it is created not init if there is no variable
+  * @param[in] symbol - id of name of variable
+  * @return variable
+  */
+  Variable& GetSlot(uint32_t symbol);
+
+  /**
+  * @brief method of binding variables of context to slots of expression
+  * @param[in] expression - compiled expression
+  * @return binding with pointers to variables of context
+  */
+  VariableBinding Bind(const CompiledExpression& expression);
+
+  /**
+  * @brief indexes of variables in storage, index is id of name of variable, SymbolTable::NONE if there is no variable
+  */
+  std::vector<uint32_t> slots;
+
+  /**
+  * @brief variables, addresses of them do not change when new variables are added
+  */
+  std::deque<Variable> storage;
+};
+
+
+
+
+/**
+* @brief singleton class of context of global variables, the default context of REPL
+*/
+class VariableManager : public EvaluationContext {
 public:
   /**
   * @brief copy consructor (deleted)
@@ -42,40 +156,16 @@ public:
   * @return exemplar of class
   */
   static VariableManager& GetInstance(void);
-
-  /**
-  * @brief method of check availability of variable in internal storage
-  * @param[in] name - name of variable
-  * @return true if there is variable in internal storage, false otherwise
-  */
-  bool CheckVariable(const std::string& name) const;
-
-  /**
-  * @brief method of loading the variable into internal storage
-  * @param[in] var - variable, which you want to load
-  */
-  void AddVariable(Variable var);
-
-  /**
- * @brief getter of variable from internal storage
- * @param[in] name - name of variable
- * @return variable
- */
-  Variable FindVariable(const std::string& name) const;
 private:
   /**
   * @brief default constructor
   */
   VariableManager() = default;
-
-  /**
-  * @brief variable's internal storage
-  */
-  static std::map<std::string, Variable> variableMap;
 };
 
 /**
 * @brief expression calculating function
+* @details expression is calculated with global variables of VariableManager
 * @param[in] expression - expression for calculating
 * @return result of calculating
 */
@@ -0,0 +1,260 @@
+#include "Columnar.h"
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef _WIN32
+  file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  LARGE_INTEGER fileSize;
+  if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize)) {
+    if (file != INVALID_HANDLE_VALUE)
+      CloseHandle(file);
+    throw std::runtime_error(("Cannot open file " + path).c_str());
+  }
+  size = static_cast<size_t>(fileSize.QuadPart);
+#else
+  file = open(path.c_str(), O_RDONLY);
+  struct stat status;
+  if (file < 0 || fstat(file, &status) != 0) {
+    if (file >= 0)
+      close(file);
+    throw std::runtime_error(("Cannot open file " + path).c_str());
+  }
+  size = static_cast<size_t>(status.st_size);
+#endif
+  Map(path, false);
+}
+
+MappedFile::MappedFile(const std::string& path, size_t size) : size(size) {
+#ifdef _WIN32
+  file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    throw std::runtime_error(("Cannot create file " + path).c_str());
+#else
+  file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (file < 0)
+    throw std::runtime_error(("Cannot create file " + path).c_str());
+  if (ftruncate(file, static_cast<off_t>(size)) != 0) {
+    close(file);
+    throw std::runtime_error(("Cannot create file " + path).c_str());
+  }
+#endif
+  Map(path, true);
+}
+
+void MappedFile::Map(const std::string& path, bool writable) {
+  if (size == 0)
+    return;
+#ifdef _WIN32
+  //mapping of writable file sets its size
+  mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+                               static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size), nullptr);
+  if (mapping != nullptr)
+    data = static_cast<unsigned char*>(MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size));
+  if (data == nullptr) {
+    if (mapping != nullptr)
+      CloseHandle(mapping);
+    CloseHandle(file);
+    throw std::runtime_error(("Cannot map file " + path).c_str());
+  }
+#else
+  void* address = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0);
+  if (address == MAP_FAILED) {
+    close(file);
+    throw std::runtime_error(("Cannot map file " + path).c_str());
+  }
+  data = static_cast<unsigned char*>(address);
+  if (!writable)
+    madvise(address, size, MADV_SEQUENTIAL);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+  if (data != nullptr)
+    UnmapViewOfFile(data);
+  if (mapping != nullptr)
+    CloseHandle(mapping);
+  CloseHandle(file);
+#else
+  if (data != nullptr)
+    munmap(data, size);
+  close(file);
+#endif
+}
+
+unsigned char* MappedFile::GetData(void) const {
+  return data;
+}
+
+size_t MappedFile::GetSize(void) const {
+  return size;
+}
+
+/**
+* @brief function of rounding size up to COLUMNAR_ALIGNMENT
+* @param[in] size - size
+* @return aligned size
+*/
+uint64_t AlignColumnar(uint64_t size) {
+  return (size + COLUMNAR_ALIGNMENT - 1) / COLUMNAR_ALIGNMENT * COLUMNAR_ALIGNMENT;
+}
+
+/**
+* @brief function of computing size of columnar file's header
+* @param[in] names - names of columns
+* @return aligned size of header
+*/
+uint64_t GetColumnarHeaderSize(const std::vector<std::string>& names) {
+  uint64_t size = sizeof(COLUMNAR_MAGIC) + 2 * sizeof(uint64_t);
+  for (auto& name : names)
+    size += 2 * sizeof(uint32_t) + sizeof(uint64_t) + name.size();
+  return AlignColumnar(size);
+}
+
+/**
+* @brief function of check that numbers in memory are little-endian
+* @return true if processor is little-endian, false otherwise
+*/
+bool IsLittleEndian(void) {
+  const uint16_t probe = 1;
+  unsigned char first;
+  std::memcpy(&first, &probe, 1);
+  return first == 1;
+}
+
+ColumnarReader::ColumnarReader(const std::string& path) : file(path) {
+  if (!IsLittleEndian())
+    throw std::runtime_error("Columnar files are supported only on little-endian processors");
+
+  const unsigned char* data = file.GetData();
+  size_t size = file.GetSize();
+  size_t position = 0;
+  auto read = [&](void* value, size_t length) {
+    if (size - position < length)
+      throw std::runtime_error(("Truncated header of file " + path).c_str());
+    std::memcpy(value, data + position, length);
+    position += length;
+  };
+
+  char magic[sizeof(COLUMNAR_MAGIC)];
+  read(magic, sizeof(magic));
+  if (std::memcmp(magic, COLUMNAR_MAGIC, sizeof(magic)) != 0)
+    throw std::runtime_error(("File " + path + " is not a columnar file").c_str());
+  uint64_t rowsNum, columnsNum;
+  read(&rowsNum, sizeof(rowsNum));
+  read(&columnsNum, sizeof(columnsNum));
+  if (rowsNum > size / sizeof(double))
+    throw std::runtime_error(("Wrong number of rows in file " + path).c_str());
+  rowsCount = static_cast<size_t>(rowsNum);
+
+  for (uint64_t i = 0; i < columnsNum; ++i) {
+    uint32_t type, nameLength;
+    uint64_t offset;
+    read(&type, sizeof(type));
+    read(&nameLength, sizeof(nameLength));
+    read(&offset, sizeof(offset));
+    if (size - position < nameLength)
+      throw std::runtime_error(("Truncated header of file " + path).c_str());
+    std::string name(reinterpret_cast<const char*>(data + position), nameLength);
+    position += nameLength;
+    if (type != static_cast<uint32_t>(ColumnType::FLOAT64))
+      throw std::runtime_error(("Unsupported type of column " + name).c_str());
+    if (offset % sizeof(double) != 0 || offset > size || (size - offset) / sizeof(double) < rowsNum)
+      throw std::runtime_error(("Wrong offset of column " + name).c_str());
+    names.push_back(std::move(name));
+    columns.push_back(reinterpret_cast<const double*>(data + offset));
+  }
+}
+
+size_t ColumnarReader::GetRowsCount(void) const {
+  return rowsCount;
+}
+
+const std::vector<std::string>& ColumnarReader::GetNames(void) const {
+  return names;
+}
+
+const double* ColumnarReader::FindColumn(const std::string& name) const {
+  for (size_t i = 0; i < names.size(); ++i)
+    if (names[i] == name)
+      return columns[i];
+  return nullptr;
+}
+
+ColumnarWriter::ColumnarWriter(const std::string& path, const std::vector<std::string>& names, size_t rowsNum)
+  : file(path, static_cast<size_t>(GetColumnarHeaderSize(names) + names.size() * AlignColumnar(rowsNum * sizeof(double)))) {
+  if (!IsLittleEndian())
+    throw std::runtime_error("Columnar files are supported only on little-endian processors");
+
+  unsigned char* data = file.GetData();
+  size_t position = 0;
+  auto write = [&](const void* value, size_t length) {
+    std::memcpy(data + position, value, length);
+    position += length;
+  };
+
+  uint64_t rowsCount = rowsNum;
+  uint64_t columnsCount = names.size();
+  uint64_t offset = GetColumnarHeaderSize(names);
+  write(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+  write(&rowsCount, sizeof(rowsCount));
+  write(&columnsCount, sizeof(columnsCount));
+  for (auto& name : names) {
+    uint32_t type = static_cast<uint32_t>(ColumnType::FLOAT64);
+    uint32_t nameLength = static_cast<uint32_t>(name.size());
+    write(&type, sizeof(type));
+    write(&nameLength, sizeof(nameLength));
+    write(&offset, sizeof(offset));
+    write(name.data(), name.size());
+    columns.push_back(reinterpret_cast<double*>(data + offset));
+    offset += AlignColumnar(rowsNum * sizeof(double));
+  }
+}
+
+double* ColumnarWriter::GetColumn(size_t index) const {
+  return columns[index];
+}
+
+size_t EvaluateColumnar(const std::string& inputPath, const std::vector<std::string>& expressions, const std::string& outputPath, ThreadPool* pool) {
+  CompiledExpression expression = CompileFused(expressions);
+  ColumnarReader reader(inputPath);
+  std::vector<const double*> columns(expression.GetVariablesCount());
+  for (size_t slot = 0; slot < columns.size(); ++slot)
+    columns[slot] = reader.FindColumn(expression.GetVariableName(slot));
+
+  size_t rowsNum = reader.GetRowsCount();
+  //results are written to temporary file, so output file is not replaced by partly evaluated one
+  std::string tempPath = outputPath + "." + std::to_string(std::random_device()());
+  std::error_code code;
+  try {
+    ColumnarWriter writer(tempPath, GetResultNames(expressions), rowsNum);
+    std::vector<double*> outputs(expressions.size());
+    for (size_t i = 0; i < outputs.size(); ++i)
+      outputs[i] = writer.GetColumn(i);
+    if (pool != nullptr)
+      EvaluateFusedBatch(expression, columns.data(), rowsNum, outputs.data(), *pool);
+    else
+      EvaluateFusedBatch(expression, columns.data(), rowsNum, outputs.data());
+  }
+  catch (const std::exception&) {
+    std::filesystem::remove(tempPath, code);
+    throw;
+  }
+  std::filesystem::rename(tempPath, outputPath, code);
+  if (code) {
+    std::filesystem::remove(tempPath, code);
+    throw std::runtime_error(("Cannot create file " + outputPath).c_str());
+  }
+  return rowsNum;
+}
\ No newline at end of file
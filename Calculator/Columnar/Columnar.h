@@ -0,0 +1,233 @@
+#pragma once
+
+#include "../Interpreter/Interpreter.h"
+#include <cstdint>
+
+/**
+* @brief signature of columnar file
+*/
+constexpr char COLUMNAR_MAGIC[8] = { 'C', 'A', 'L', 'C', 'C', 'O', 'L', '1' };
+
+/**
+* @brief alignment of header's end and of every column in columnar file
+*/
+constexpr size_t COLUMNAR_ALIGNMENT = 64;
+
+/**
+* @brief enum class of types of columns in columnar file
+*/
+enum class ColumnType : uint32_t {
+  FLOAT64 = 1,   ///< little-endian IEEE 754 double
+};
+
+/**
+* @brief class of file mapped into memory
+*/
+class MappedFile {
+public:
+  /**
+  * @brief default consructor (deleted)
+  * @warning the method is deleted
+  */
+  MappedFile() = delete;
+
+  /**
+  * @brief constructor, maps existing file for reading
+  * @param[in] path - path to file
+  * @throw std::exception if file can not be opened or mapped
+  */
+  explicit MappedFile(const std::string& path);
+
+  /**
+  * @brief constructor, creates file of given size and maps it for reading and writing
+  * @param[in] path - path to file
+  * @param[in] size - size of file
+  * @throw std::exception if file can not be created or mapped
+  */
+  MappedFile(const std::string& path, size_t size);
+
+  /**
+  * @brief copy consructor (deleted)
+  * @warning the method is deleted
+  */
+  MappedFile(const MappedFile&) = delete;
+
+  /**
+  * @brief copy operator (deleted)
+  * @warning the operator is deleted
+  */
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+  * @brief destructor, unmaps and closes file, written data is kept
+  */
+  ~MappedFile();
+
+  /**
+  * @brief getter of mapped data
+  * @return mapped data, nullptr if file is empty
+  */
+  unsigned char* GetData(void) const;
+
+  /**
+  * @brief getter of size of file
+  * @return size of file
+  */
+  size_t GetSize(void) const;
+private:
+  /**
+  * @brief method of mapping opened file
+  * @param[in] path - path to file for error message
+  * @param[in] writable - true if file is mapped for writing
+  */
+  void Map(const std::string& path, bool writable);
+
+  /**
+  * @brief mapped data
+  */
+  unsigned char* data = nullptr;
+
+  /**
+  * @brief size of file
+  */
+  size_t size = 0;
+
+#ifdef _WIN32
+  /**
+  * @brief handle of file
+  */
+  void* file = nullptr;
+
+  /**
+  * @brief handle of file mapping
+  */
+  void* mapping = nullptr;
+#else
+  /**
+  * @brief descriptor of file
+  */
+  int file = -1;
+#endif
+};
+
+
+
+
+/**
+* @brief class of columnar file opened for reading
+* @details file starts with COLUMNAR_MAGIC, number of rows and number of columns as uint64,
+* then for every column its type and length of its name as uint32, offset of its data from file's begin as uint64 and the name,
+* data of every column is rows number of values aligned to COLUMNAR_ALIGNMENT, all numbers are little-endian.
+* Columns are used in place, without copying
+*/
+class ColumnarReader {
+public:
+  /**
+  * @brief default consructor (deleted)
+  * @warning the method is deleted
+  */
+  ColumnarReader() = delete;
+
+  /**
+  * @brief constructor, maps file and checks header
+  * @param[in] path - path to file
+  * @throw std::exception if file can not be mapped or is not a valid columnar file
+  */
+  explicit ColumnarReader(const std::string& path);
+
+  /**
+  * @brief getter of number of rows
+  * @return number of rows
+  */
+  size_t GetRowsCount(void) const;
+
+  /**
+  * @brief getter of names of columns
+  * @return names of columns
+  */
+  const std::vector<std::string>& GetNames(void) const;
+
+  /**
+  * @brief getter of column
+  * @param[in] name - name of column
+  * @return values of column, nullptr if there is no column with this name
+  */
+  const double* FindColumn(const std::string& name) const;
+private:
+  /**
+  * @brief mapped file
+  */
+  MappedFile file;
+
+  /**
+  * @brief number of rows
+  */
+  size_t rowsCount = 0;
+
+  /**
+  * @brief names of columns
+  */
+  std::vector<std::string> names;
+
+  /**
+  * @brief values of columns
+  */
+  std::vector<const double*> columns;
+};
+
+
+
+
+/**
+* @brief class of columnar file created for writing
+* @details file has the same layout as one read by ColumnarReader, header is written by constructor
+*/
+class ColumnarWriter {
+public:
+  /**
+  * @brief default consructor (deleted)
+  * @warning the method is deleted
+  */
+  ColumnarWriter() = delete;
+
+  /**
+  * @brief constructor, creates and maps file
+  * @param[in] path - path to file
+  * @param[in] names - names of columns
+  * @param[in] rowsNum - number of rows
+  * @throw std::exception if file can not be created
+  */
+  ColumnarWriter(const std::string& path, const std::vector<std::string>& names, size_t rowsNum);
+
+  /**
+  * @brief getter of column for writing
+  * @param[in] index - index of column
+  * @return values of column
+  */
+  double* GetColumn(size_t index) const;
+private:
+  /**
+  * @brief mapped file
+  */
+  MappedFile file;
+
+  /**
+  * @brief values of columns
+  */
+  std::vector<double*> columns;
+};
+
+/**
+* @brief function of evaluating expressions for every row of columnar file
+* @details expressions are compiled into one fused program, its variables are bound to mapped columns with the same names
+* and results are written to mapped output file, so data is not copied or parsed. Output file has column for every expression named like in EvaluateCsv
+* @details results are written to temporary file next to output file, which replaces output file only after all rows are evaluated,
+* so output file is left untouched if evaluating fails
+* @param[in] inputPath - path to input columnar file
+* @param[in] expressions - expressions
+* @param[in] outputPath - path to output columnar file
+* @param[in] pool - thread pool which evaluates rows, nullptr to evaluate on calling thread
+* @return number of rows
+* @throw std::exception if files can not be mapped, expression can not be compiled or evaluating of any row fails
+*/
+size_t EvaluateColumnar(const std::string& inputPath, const std::vector<std::string>& expressions, const std::string& outputPath, ThreadPool* pool);
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "CompileCache.h"
+#include <cctype>
+
+CompileCache::CompileCache(size_t capacity) : capacity(capacity) {}
+
+CompileCache& CompileCache::GetInstance(void) {
+  static CompileCache self;
+  return self;
+}
+
+std::string CompileCache::Normalize(std::string_view expression) {
+  std::string key;
+  key.reserve(expression.size());
+  bool space = false;
+  for (char symbol : expression) {
+    if (std::isspace(static_cast<unsigned char>(symbol))) {
+      space = true;
+      continue;
+    }
+    if (space && !key.empty() && key.back() != DELIMETR_ARGS && symbol != DELIMETR_ARGS)
+      key.push_back(' ');
+    space = false;
+    key.push_back(symbol);
+  }
+  return key;
+}
+
+std::shared_ptr<TieredExpression> CompileCache::Compile(const std::string& expression) {
+  std::shared_ptr<const OperationsSnapshot> operations = OperationsDescription::GetInstance().GetSnapshot();
+  std::string key = Normalize(expression);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(key);
+    if (found != index.end() && found->second->generation == operations->GetGeneration()) {
+      entries.splice(entries.begin(), entries, found->second);
+      ++hits;
+      return found->second->program;
+    }
+    ++misses;
+  }
+
+  auto program = std::make_shared<TieredExpression>(::Compile(key, operations));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if (capacity == 0)
+    return program;
+  auto found = index.find(key);
+  if (found != index.end()) {
+    if (found->second->generation <= operations->GetGeneration()) {
+      found->second->generation = operations->GetGeneration();
+      found->second->program = program;
+    }
+    entries.splice(entries.begin(), entries, found->second);
+    return program;
+  }
+  entries.push_front({ std::move(key), operations->GetGeneration(), program });
+  index.emplace(entries.front().key, entries.begin());
+  Evict();
+  return program;
+}
+
+CompileCache::Statistics CompileCache::GetStatistics(void) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return { hits, misses, evictions, entries.size(), capacity };
+}
+
+void CompileCache::SetCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex);
+  this->capacity = capacity;
+  Evict();
+}
+
+void CompileCache::Clear(void) {
+  std::lock_guard<std::mutex> lock(mutex);
+  index.clear();
+  entries.clear();
+}
+
+void CompileCache::Evict(void) {
+  while (entries.size() > capacity) {
+    index.erase(entries.back().key);
+    entries.pop_back();
+    ++evictions;
+  }
+}
\ No newline at end of file
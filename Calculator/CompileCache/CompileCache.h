@@ -0,0 +1,149 @@
+#pragma once
+
+#include "../JIT/JIT.h"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+* @brief default number of expressions kept by CompileCache
+*/
+constexpr size_t COMPILE_CACHE_CAPACITY = 4096;
+
+/**
+* @brief class of bounded cache of compiled expressions with least recently used eviction
+* @details expressions are keyed by normalized text, so expressions which differ only in whitespace share one entry.
+* Every entry remembers generation of snapshot of operations it is compiled with, entry of older generation
+* is compiled again at the next lookup, so loading or clearing operations invalidates cache automatically.
+* Entries are tiered expressions, so expression which is calculated often is compiled into machine code once for all users.
+* The class is thread safe, expressions are compiled outside of lock.
+*/
+class CompileCache {
+public:
+  /**
+  * @brief struct of counters of cache
+  */
+  struct Statistics {
+    size_t hits;        ///< number of lookups which found actual entry
+    size_t misses;      ///< number of lookups which compiled expression
+    size_t evictions;   ///< number of entries dropped because cache is full
+    size_t size;        ///< number of entries
+    size_t capacity;    ///< maximum number of entries
+  };
+
+  /**
+  * @brief constructor
+  * @param[in] capacity - maximum number of entries, 0 disables caching
+  */
+  explicit CompileCache(size_t capacity = COMPILE_CACHE_CAPACITY);
+
+  /**
+  * @brief copy consructor (deleted)
+  * @warning the method is deleted
+  */
+  CompileCache(const CompileCache&) = delete;
+
+  /**
+  * @brief copy operator (deleted)
+  * @warning the operator is deleted
+  */
+  CompileCache& operator=(const CompileCache&) = delete;
+
+  /**
+  * @brief default destructor
+  */
+  ~CompileCache() = default;
+
+  /**
+  * @brief getter of cache used by Calculate
+  * @return exemplar of class
+  */
+  static CompileCache& GetInstance(void);
+
+  /**
+  * @brief method of getting compiled expression, it is compiled if there is no actual entry
+  * @param[in] expression - expression in string form
+  * @return tiered compiled expression, it stays valid after entry is evicted
+  * @throw std::exception if expression can not be compiled, errors are not cached
+  */
+  std::shared_ptr<TieredExpression> Compile(const std::string& expression);
+
+  /**
+  * @brief getter of counters
+  * @return counters
+  */
+  Statistics GetStatistics(void) const;
+
+  /**
+  * @brief method of changing maximum number of entries, least recently used entries are evicted
+  * @param[in] capacity - maximum number of entries, 0 disables caching
+  */
+  void SetCapacity(size_t capacity);
+
+  /**
+  * @brief method of dropping all entries, counters are kept
+  */
+  void Clear(void);
+
+  /**
+  * @brief method of normalizing expression to key of cache
+  * @details runs of whitespace become one space, whitespace at the ends and around separators of arguments is dropped,
+  * the rest is kept, because operation's names may contain almost any characters and space may split tokens
+  * @param[in] expression - expression in string form
+  * @return key
+  */
+  static std::string Normalize(std::string_view expression);
+private:
+  /**
+  * @brief struct of cached expression
+  */
+  struct Entry {
+    std::string key;                                      ///< normalized expression
+    uint64_t generation;                                  ///< generation of snapshot of operations expression is compiled with
+    std::shared_ptr<TieredExpression> program;            ///< compiled expression
+  };
+
+  /**
+  * @brief method of dropping least recently used entries while there are more than capacity
+  * @warning the method must be called under mutex
+  */
+  void Evict(void);
+
+  /**
+  * @brief entries, the most recently used is the first
+  */
+  std::list<Entry> entries;
+
+  /**
+  * @brief entries by key, keys are views of keys of entries
+  */
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+
+  /**
+  * @brief maximum number of entries
+  */
+  size_t capacity;
+
+  /**
+  * @brief number of lookups which found actual entry
+  */
+  size_t hits = 0;
+
+  /**
+  * @brief number of lookups which compiled expression
+  */
+  size_t misses = 0;
+
+  /**
+  * @brief number of entries dropped because cache is full
+  */
+  size_t evictions = 0;
+
+  /**
+  * @brief guard of entries and counters
+  */
+  mutable std::mutex mutex;
+};
\ No newline at end of file
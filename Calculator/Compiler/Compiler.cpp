@@ -0,0 +1,786 @@
+#include "Compiler.h"
+#include "../BaseOperations/BaseOperation.h"
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <map>
+
+void CompiledExpression::Push(size_t start, bool pure) {
+  operands.push_back({ start, pure });
+  if (operands.size() > maxDepth)
+    maxDepth = operands.size();
+}
+
+bool CompiledExpression::IsSingle(size_t operand, OpCode code) const {
+  size_t end = operand + 1 < operands.size() ? operands[operand + 1].start : program.size();
+  return end - operands[operand].start == 1 && program[operands[operand].start].code == code;
+}
+
+bool CompiledExpression::Fold(const Operation& operation, size_t first) {
+  for (size_t i = first; i < operands.size(); ++i)
+    if (!IsSingle(i, OpCode::PUSH_LITERAL))
+      return false;
+
+  size_t argsNum = operands.size() - first;
+  std::vector<Value> storage(argsNum + 1);
+  for (size_t i = 0; i < argsNum; ++i)
+    storage[i] = literals[program[operands[first + i].start].arg];
+  Operation::DataStack dataStack(storage.data(), storage.size(), argsNum);
+  try {
+    operation.DoOperation(dataStack);
+  }
+  catch (const std::exception&) {
+    return false;   //error is reported when expression is evaluated
+  }
+
+  program.resize(argsNum == 0 ? program.size() : operands[first].start);
+  operands.resize(first);
+  AddLiteral(dataStack.top().GetValue());
+  return true;
+}
+
+bool CompiledExpression::Simplify(OpCode code, size_t first) {
+  if (operands.size() - first != 2)
+    return false;
+  size_t left = first;
+  size_t right = first + 1;
+  auto isLiteral = [this](size_t operand, double value) {
+    return IsSingle(operand, OpCode::PUSH_LITERAL) && literals[program[operands[operand].start].arg] == value;
+  };
+
+  //x+0 and 0+x are kept, since -0+0 is +0
+  if (((code == OpCode::MUL || code == OpCode::DIV) && isLiteral(right, 1)) || (code == OpCode::SUB && isLiteral(right, 0))) {
+    program.erase(program.begin() + operands[right].start);
+    operands.pop_back();
+  }
+  else if (code == OpCode::MUL && isLiteral(left, 1)) {
+    program.erase(program.begin() + operands[left].start);
+    operands[right].start = operands[left].start;
+    operands.erase(operands.begin() + left);
+  }
+  else
+    return false;
+  LoadVariables(first);
+  return true;
+}
+
+void CompiledExpression::LoadVariables(size_t first) {
+  for (size_t i = operands.size(); i-- > first; ) {
+    if (IsSingle(i, OpCode::PUSH_VARIABLE))
+      program[operands[i].start].code = OpCode::LOAD_VARIABLE;
+    if (!operands[i].pure)
+      break;  //value of earlier variables may be changed before operation
+  }
+}
+
+void CompiledExpression::AddLiteral(double value) {
+  Push(program.size(), true);
+  literals.push_back(value);
+  program.push_back({ OpCode::PUSH_LITERAL, literals.size() - 1 });
+}
+
+void CompiledExpression::AddVariable(std::string_view name, uint32_t symbol) {
+  auto slot = std::find(symbols.begin(), symbols.end(), symbol);
+  if (slot == symbols.end()) {
+    slot = symbols.insert(symbols.end(), symbol);
+    variables.emplace_back(name);
+  }
+  Push(program.size(), true);
+  program.push_back({ OpCode::PUSH_VARIABLE, size_t(slot - symbols.begin()) });
+}
+
+void CompiledExpression::AddOperation(const OperationDescriptor& descriptor) {
+  if (descriptor.type == ElementType::CLOSE_BRACKET)
+    return;
+  size_t argsNum = descriptor.argsNum;
+  if (operands.size() < argsNum)
+    throw std::runtime_error("Unexpected number of arguments");
+  if (!descriptor.hasOperation)
+    return;
+
+  const Operation& operation = *descriptor.operation;
+  size_t first = operands.size() - argsNum;
+  size_t start = argsNum == 0 ? program.size() : operands[first].start;
+  bool pure = descriptor.pure;
+  for (size_t i = first; i < operands.size(); ++i)
+    pure = pure && operands[i].pure;
+
+  if (descriptor.pure && Fold(operation, first))
+    return;
+  Instruction instruction = Lower(operation);
+  instruction.pure = descriptor.pure;
+  if (descriptor.pure && Simplify(instruction.code, first))
+    return;
+  if (descriptor.pure)
+    LoadVariables(first);
+
+  if (instruction.code == OpCode::CALL_OPERATION) {
+    operations.push_back(descriptor.operation);
+    instruction.arg = operations.size() - 1;
+  }
+  operands.resize(first);
+  Push(start, pure);
+  program.push_back(instruction);
+}
+
+CompiledExpression::Instruction CompiledExpression::Lower(const Operation& operation) {
+  Instruction instruction = { OpCode::CALL_OPERATION, 0 };
+  switch (operation.GetType()) {
+  case ElementType::BINARY: {
+    auto doOperation = static_cast<const BinaryOperator&>(operation).GetValueOperation();
+    if (doOperation == Add)
+      instruction.code = OpCode::ADD;
+    else if (doOperation == Sub)
+      instruction.code = OpCode::SUB;
+    else if (doOperation == Mul)
+      instruction.code = OpCode::MUL;
+    else if (doOperation == Div)
+      instruction.code = OpCode::DIV;
+    else if (doOperation == Assign)
+      instruction.code = OpCode::ASSIGN;
+    else if (doOperation != nullptr) {
+      instruction.code = OpCode::CALL_BINARY;
+      instruction.callback.binary = doOperation;
+    }
+    break;
+  }
+  case ElementType::PREFICS: {
+    auto doOperation = static_cast<const PreficsOperator&>(operation).GetValueOperation();
+    if (doOperation == UnaryMinus)
+      instruction.code = OpCode::NEG;
+    else if (doOperation == PrefixIncrement)
+      instruction.code = OpCode::PRE_INC;
+    else if (doOperation == PrefixDecrement)
+      instruction.code = OpCode::PRE_DEC;
+    else if (doOperation != nullptr) {
+      instruction.code = OpCode::CALL_UNARY;
+      instruction.callback.unary = doOperation;
+    }
+    break;
+  }
+  case ElementType::POSTFICS: {
+    auto doOperation = static_cast<const PostficsOperator&>(operation).GetValueOperation();
+    if (doOperation == PostfixIncrement)
+      instruction.code = OpCode::POST_INC;
+    else if (doOperation == PostfixDecrement)
+      instruction.code = OpCode::POST_DEC;
+    else if (doOperation != nullptr) {
+      instruction.code = OpCode::CALL_UNARY;
+      instruction.callback.unary = doOperation;
+    }
+    break;
+  }
+  case ElementType::OPEN_BRACKET: {
+    auto doOperation = static_cast<const OpenBracket&>(operation).GetValueOperation();
+    if (doOperation != nullptr) {
+      instruction.code = OpCode::CALL_UNARY;
+      instruction.callback.unary = doOperation;
+    }
+    break;
+  }
+  case ElementType::FUNCTION: {
+    auto& function = static_cast<const Function&>(operation);
+    if (function.GetBinaryOperation() == Max)
+      instruction.code = OpCode::MAX;
+    else if (function.GetUnaryOperation() != nullptr) {
+      instruction.code = OpCode::CALL_FUNC1;
+      instruction.callback.func1 = function.GetUnaryOperation();
+    }
+    else if (function.GetBinaryOperation() != nullptr) {
+      instruction.code = OpCode::CALL_FUNC2;
+      instruction.callback.func2 = function.GetBinaryOperation();
+    }
+    else if (function.GetSpanOperation() != nullptr) {
+      instruction = { OpCode::CALL_FUNCN, size_t(function.GetArgsNum()) };
+      instruction.callback.funcN = function.GetSpanOperation();
+    }
+    break;
+  }
+  default:
+    break;
+  }
+  if (instruction.code == OpCode::CALL_BINARY || instruction.code == OpCode::CALL_UNARY || instruction.code == OpCode::CALL_FUNC1 ||
+      instruction.code == OpCode::CALL_FUNC2 || instruction.code == OpCode::CALL_FUNCN)
+    instruction.batch = operation.GetBatchOperation();
+  return instruction;
+}
+
+void CompiledExpression::AddOutput(void) {
+  if (operands.size() != 1)
+    throw std::runtime_error("Error expression");
+  program.push_back({ OpCode::STORE_OUTPUT, storedCount++, {}, false });
+  operands.clear();
+}
+
+void CompiledExpression::AddReturn(void) {
+  if (operands.size() != 1)
+    throw std::runtime_error("Error expression");
+  program.push_back({ OpCode::RETURN, 0 });
+  Share();
+}
+
+size_t CompiledExpression::GetArgsNum(const Instruction& instruction) const {
+  switch (instruction.code) {
+  case OpCode::ADD:
+  case OpCode::SUB:
+  case OpCode::MUL:
+  case OpCode::DIV:
+  case OpCode::ASSIGN:
+  case OpCode::MAX:
+  case OpCode::CALL_BINARY:
+  case OpCode::CALL_FUNC2:
+    return 2;
+  case OpCode::NEG:
+  case OpCode::PRE_INC:
+  case OpCode::PRE_DEC:
+  case OpCode::POST_INC:
+  case OpCode::POST_DEC:
+  case OpCode::CALL_UNARY:
+  case OpCode::CALL_FUNC1:
+  case OpCode::STORE_OUTPUT:
+    return 1;
+  case OpCode::CALL_FUNCN:
+    return instruction.arg;
+  case OpCode::CALL_OPERATION: {
+    auto& operation = operations[instruction.arg];
+    if (operation->GetType() == ElementType::BINARY)
+      return 2;
+    if (operation->GetType() == ElementType::FUNCTION)
+      return dynamic_cast<Function*>(operation.get())->GetArgsNum();
+    return 1;
+  }
+  default:
+    return 0;
+  }
+}
+
+void CompiledExpression::Share(void) {
+  const size_t NONE = SIZE_MAX;   //node of operand which can not be shared
+  struct Operand {
+    size_t start;
+    size_t node;
+  };
+  struct Replacement {
+    size_t start;
+    size_t end;
+    size_t node;
+  };
+  std::map<std::vector<uint64_t>, size_t> nodes;
+  std::vector<size_t> definitions;
+  std::vector<size_t> uses;
+  std::vector<Operand> stack;
+  std::vector<Replacement> replacements;
+  std::vector<size_t> versions(variables.size());   //the last side effect which may change variable
+  size_t effects = 0;   //number of instructions with side effects executed before
+
+  for (size_t i = 0; i + 1 < program.size(); ++i) {
+    const Instruction& instruction = program[i];
+    if (instruction.code == OpCode::STORE_OUTPUT) {
+      stack.pop_back();
+      continue;
+    }
+    size_t argsNum = GetArgsNum(instruction);
+    size_t first = stack.size() - argsNum;
+    size_t start = argsNum == 0 ? i : stack[first].start;
+
+    std::vector<uint64_t> key = { uint64_t(instruction.code) };
+    switch (instruction.code) {
+    case OpCode::PUSH_LITERAL: {
+      double value = literals[instruction.arg];
+      uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      key.push_back(bits);
+      break;
+    }
+    case OpCode::LOAD_VARIABLE:
+      key.push_back(instruction.arg);
+      key.push_back(versions[instruction.arg]);
+      break;
+    case OpCode::CALL_OPERATION:
+      key.push_back(uint64_t(uintptr_t(operations[instruction.arg].get())));
+      break;
+    default: {
+      uint64_t callback = 0;
+      std::memcpy(&callback, &instruction.callback, sizeof(instruction.callback));
+      key.push_back(instruction.arg);
+      key.push_back(callback);
+      break;
+    }
+    }
+    bool pure = instruction.pure && instruction.code != OpCode::PUSH_VARIABLE;
+    for (size_t j = first; j < stack.size(); ++j) {
+      pure = pure && stack[j].node != NONE;
+      key.push_back(stack[j].node);
+    }
+
+    size_t node = NONE;
+    if (pure) {
+      auto found = nodes.emplace(std::move(key), definitions.size());
+      node = found.first->second;
+      if (found.second) {
+        definitions.push_back(i);
+        uses.push_back(0);
+      }
+      else if (argsNum != 0) {
+        //repeated subexpressions inside this one are not computed anymore
+        while (!replacements.empty() && replacements.back().start >= start) {
+          --uses[replacements.back().node];
+          replacements.pop_back();
+        }
+        replacements.push_back({ start, i, node });
+        ++uses[node];
+      }
+    }
+    if (!instruction.pure) {
+      //variables are changed only through references pushed by the subexpression,
+      //operation called through DoOperation has access to the whole stack
+      ++effects;
+      if (instruction.code == OpCode::CALL_OPERATION)
+        std::fill(versions.begin(), versions.end(), effects);
+      else
+        for (size_t j = start; j < i; ++j)
+          if (program[j].code == OpCode::PUSH_VARIABLE)
+            versions[program[j].arg] = effects;
+    }
+    stack.resize(first);
+    stack.push_back({ start, node });
+  }
+  if (replacements.empty())
+    return;
+
+  std::vector<size_t> temps(definitions.size(), NONE);
+  std::vector<size_t> defined(program.size(), NONE);
+  for (size_t node = 0; node < definitions.size(); ++node)
+    if (uses[node] != 0) {
+      temps[node] = tempsCount++;
+      defined[definitions[node]] = node;
+    }
+
+  std::vector<Instruction> shared;
+  shared.reserve(program.size() + tempsCount);
+  size_t next = 0;
+  for (size_t i = 0; i < program.size(); ++i) {
+    if (next < replacements.size() && replacements[next].start == i) {
+      shared.push_back({ OpCode::LOAD_TEMP, temps[replacements[next].node] });
+      i = replacements[next++].end;
+      continue;
+    }
+    shared.push_back(program[i]);
+    if (defined[i] != NONE)
+      shared.push_back({ OpCode::SAVE_TEMP, temps[defined[i]] });
+  }
+  program = std::move(shared);
+}
+
+const std::vector<CompiledExpression::Instruction>& CompiledExpression::GetProgram(void) const {
+  return program;
+}
+
+double CompiledExpression::GetLiteral(size_t index) const {
+  return literals[index];
+}
+
+const std::shared_ptr<Operation>& CompiledExpression::GetOperation(size_t index) const {
+  return operations[index];
+}
+
+size_t CompiledExpression::GetVariablesCount(void) const {
+  return variables.size();
+}
+
+const std::string& CompiledExpression::GetVariableName(size_t slot) const {
+  return variables[slot];
+}
+
+uint32_t CompiledExpression::GetVariableSymbol(size_t slot) const {
+  return symbols[slot];
+}
+
+bool CompiledExpression::CheckVariable(const std::string& name) const {
+  return std::find(variables.begin(), variables.end(), name) != variables.end();
+}
+
+size_t CompiledExpression::FindVariable(const std::string& name) const {
+  auto slot = std::find(variables.begin(), variables.end(), name);
+  if (slot == variables.end())
+    throw std::runtime_error("Unknown variable name");
+  return slot - variables.begin();
+}
+
+size_t CompiledExpression::GetDepth(void) const {
+  return operands.size();
+}
+
+size_t CompiledExpression::GetMaxDepth(void) const {
+  return maxDepth;
+}
+
+size_t CompiledExpression::GetOutputsCount(void) const {
+  return storedCount + 1;
+}
+
+size_t CompiledExpression::GetTempsCount(void) const {
+  return tempsCount;
+}
+
+
+
+VariableBinding::VariableBinding(const CompiledExpression& expression) {
+  own.reserve(expression.GetVariablesCount());
+  for (size_t slot = 0; slot < expression.GetVariablesCount(); ++slot)
+    own.emplace_back(expression.GetVariableName(slot));
+  Rebind();
+}
+
+VariableBinding::VariableBinding(std::vector<Variable*> variables) : slots(std::move(variables)) {}
+
+VariableBinding::VariableBinding(const VariableBinding& other) : own(other.own), slots(other.slots) {
+  Rebind();
+}
+
+VariableBinding& VariableBinding::operator= (const VariableBinding& other) {
+  own = other.own;
+  slots = other.slots;
+  Rebind();
+  return *this;
+}
+
+void VariableBinding::Rebind(void) {
+  if (own.empty())
+    return;  //slots are bound to variables stored outside
+  slots.resize(own.size());
+  for (size_t slot = 0; slot < own.size(); ++slot)
+    slots[slot] = &own[slot];
+}
+
+void VariableBinding::SetValue(size_t slot, double value) {
+  slots[slot]->SetValue(value);
+}
+
+void VariableBinding::SetValue(const std::string& name, double value) {
+  for (auto variable : slots)
+    if (variable->GetName() == name)
+      variable->SetValue(value);
+}
+
+const Variable& VariableBinding::GetVariable(size_t slot) const {
+  return *slots[slot];
+}
+
+Variable& VariableBinding::GetVariable(size_t slot) {
+  return *slots[slot];
+}
+
+size_t VariableBinding::GetVariablesCount(void) const {
+  return slots.size();
+}
+
+
+
+/**
+* @brief function of converting the token "literal" to number
+* @param[in] literal - literal's token
+* @return value of literal
+*/
+double ParseLiteral(const Token& literal) {
+  double value = 0;
+  std::from_chars(literal.GetName().data(), literal.GetName().data() + literal.GetName().size(), value);
+  return value;
+}
+
+/**
+* @brief function to check if an operation is to be popped off the stack
+* @param[in] binaryOperator - descriptor of the binary operator that is next to the top of the stack
+* @param[in] other - descriptor of operation need to be pushed out to be checked
+* @return true if pop is necessary, false otherwise
+*/
+bool IsOperationPoped(const OperationDescriptor& binaryOperator, const OperationDescriptor& other) {
+  if (other.type == ElementType::PREFICS)
+    return other.priority > binaryOperator.priority;
+  else if (other.type == ElementType::BINARY)
+    return other.priority > binaryOperator.priority || (!other.rightAssociative && other.priority == binaryOperator.priority);
+  return false;
+}
+
+/**
+* @brief class of Pratt parser, it reads tokens once and emits operations into program in post-order
+* @details operand is parsed with the operator on its left as limit, the operand ends before binary operator
+* which the limit binds tighter than, so the order of emitted operations is the same as of two-stack shunting-yard.
+* Postfix operators are applied to the operand just parsed, prefix operators may follow only binary operators,
+* open brackets, separators of arguments and other prefix operators.
+*/
+class ExpressionParser {
+public:
+  /**
+  * @brief constructor
+  * @param[in/out] program - program which operations are emitted into
+  * @param[in] operations - operations whose names are known, descriptors are referred to while parsing
+  * @param[in] tokens - tokens of expression
+  */
+  ExpressionParser(CompiledExpression& program, const OperationsSnapshot& operations, const std::vector<Token>& tokens)
+    : program(program), operations(operations), tokens(tokens) {};
+
+  /**
+  * @brief method of parsing all tokens as one expression
+  * @throw std::exception if expression is not valid
+  */
+  void Parse(void);
+private:
+  /**
+  * @brief method of parsing operand and binary and postfix operators after it
+  * @param[in] limit - descriptor of operator on the left of operand, nullptr if there is no operator
+  */
+  void ParseExpression(const OperationDescriptor* limit);
+
+  /**
+  * @brief method of parsing literal, variable, function call, bracket or prefix operator with its operand
+  */
+  void ParsePrimary(void);
+
+  /**
+  * @brief method of parsing arguments of function call after the function's name
+  * @param[in] function - descriptor of function
+  */
+  void ParseCall(const OperationDescriptor& function);
+
+  /**
+  * @brief method of parsing expression in brackets after the open bracket
+  * @param[in] bracket - descriptor of open bracket
+  */
+  void ParseBrackets(const OperationDescriptor& bracket);
+
+  /**
+  * @brief method of reporting the token which can not continue expression
+  * @param[in] opened - descriptor of function or bracket which is not closed, nullptr if there is no one
+  * @throw std::exception always
+  */
+  [[noreturn]] void ThrowUnexpected(const OperationDescriptor* opened) const;
+
+  /**
+  * @brief program which operations are emitted into
+  */
+  CompiledExpression& program;
+
+  /**
+  * @brief operations whose names are known
+  */
+  const OperationsSnapshot& operations;
+
+  /**
+  * @brief tokens of expression
+  */
+  const std::vector<Token>& tokens;
+
+  /**
+  * @brief index of the current token
+  */
+  size_t pos = 0;
+
+  /**
+  * @brief depth of nested operands
+  */
+  size_t depth = 0;
+};
+
+void ExpressionParser::Parse(void) {
+  if (tokens.empty())
+    throw std::runtime_error("Error expression");
+  ParseExpression(nullptr);
+  if (pos < tokens.size())
+    ThrowUnexpected(nullptr);
+}
+
+void ExpressionParser::ParseExpression(const OperationDescriptor* limit) {
+  if (++depth > MAX_PARSE_DEPTH)
+    throw std::runtime_error("Too deep expression");
+  ParsePrimary();
+  while (pos < tokens.size() && tokens[pos].GetType() == Token::Type::OPERATOR) {
+    const OperationDescriptor& binary = operations.GetDescriptor(tokens[pos].GetSymbol(), ElementType::BINARY);
+    if (binary.operation) {
+      if (limit != nullptr && IsOperationPoped(binary, *limit))
+        break;
+      ++pos;
+      ParseExpression(&binary);
+      program.AddOperation(binary);
+      continue;
+    }
+    const OperationDescriptor& postfics = operations.GetDescriptor(tokens[pos].GetSymbol(), ElementType::POSTFICS);
+    if (!postfics.operation)
+      throw std::runtime_error(("Unexpected " + std::string(tokens[pos].GetName())).c_str());
+    ++pos;
+    program.AddOperation(postfics);
+  }
+  --depth;
+}
+
+void ExpressionParser::ParsePrimary(void) {
+  if (pos >= tokens.size())
+    throw std::runtime_error("Unexpected number of arguments");
+  const Token& token = tokens[pos];
+  switch (token.GetType()) {
+  case Token::Type::LITERAL:
+    program.AddLiteral(ParseLiteral(token));
+    ++pos;
+    return;
+  case Token::Type::VARIABLE:
+    program.AddVariable(token.GetName(), token.GetSymbol());
+    ++pos;
+    return;
+  case Token::Type::FUNCTION: {
+    if (pos + 1 >= tokens.size() || !tokens[pos + 1].IsSimbol(SIMBOL_BEFORE_ARGS))
+      throw std::runtime_error{ "Function call expected" };
+    pos += 2;
+    ParseCall(operations.GetDescriptor(token.GetSymbol(), ElementType::FUNCTION));
+    return;
+  }
+  case Token::Type::OPERATOR: {
+    const OperationDescriptor& prefics = operations.GetDescriptor(token.GetSymbol(), ElementType::PREFICS);
+    if (!prefics.operation)
+      throw std::runtime_error(("Unexpected " + std::string(token.GetName())).c_str());
+    ++pos;
+    ParseExpression(&prefics);
+    program.AddOperation(prefics);
+    return;
+  }
+  case Token::Type::BRACKET: {
+    const OperationDescriptor& open = operations.GetDescriptor(token.GetSymbol(), ElementType::OPEN_BRACKET);
+    if (open.operation) {
+      ++pos;
+      ParseBrackets(open);
+      return;
+    }
+    break;
+  }
+  default:
+    break;
+  }
+  if (token.GetType() == Token::Type::DELIMETR_ARGS || token.GetType() == Token::Type::BRACKET)
+    throw std::runtime_error("Unexpected number of arguments");
+  ThrowUnexpected(nullptr);
+}
+
+void ExpressionParser::ParseCall(const OperationDescriptor& function) {
+  size_t argsNum = 0;
+  if (pos < tokens.size() && tokens[pos].IsSimbol(SIMBOL_AFTER_ARGS))
+    ++pos;
+  else
+    while (true) {
+      ParseExpression(nullptr);
+      ++argsNum;
+      if (pos >= tokens.size())
+        throw std::runtime_error(("Expected " + std::string{ SIMBOL_AFTER_ARGS }).c_str());
+      if (tokens[pos].IsSimbol(SIMBOL_AFTER_ARGS)) {
+        ++pos;
+        break;
+      }
+      if (tokens[pos].GetType() != Token::Type::DELIMETR_ARGS)
+        ThrowUnexpected(&function);
+      ++pos;
+    }
+  if (argsNum != function.argsNum)
+    throw std::runtime_error("Unexpected number of arguments");
+  program.AddOperation(function);
+}
+
+void ExpressionParser::ParseBrackets(const OperationDescriptor& bracket) {
+  ParseExpression(nullptr);
+  if (pos >= tokens.size())
+    throw std::runtime_error(("Unexpected bracket" + bracket.operation->GetTokenName()).c_str());
+  const OperationDescriptor& close = operations.GetDescriptor(tokens[pos].GetSymbol(), ElementType::CLOSE_BRACKET);
+  if (!close.operation || close.pare != bracket.symbol)
+    ThrowUnexpected(&bracket);
+  ++pos;
+  program.AddOperation(bracket);
+}
+
+void ExpressionParser::ThrowUnexpected(const OperationDescriptor* opened) const {
+  const Token& token = tokens[pos];
+  if (token.GetType() == Token::Type::DELIMETR_ARGS)
+    throw std::runtime_error("Unexpected ,");
+  if (token.GetType() == Token::Type::BRACKET)
+    throw std::runtime_error(("Unexpected bracket " + (opened != nullptr ? opened->operation->GetTokenName() : std::string(token.GetName()))).c_str());
+  throw std::runtime_error("Error expression");
+}
+
+/**
+* @brief function of loading modules of deferred operations which are used in expression
+* @param[in] tokens - separated expression
+* @param[in/out] operations - operations which expression is separated by, the current snapshot is pinned if any module is loaded
+*/
+void ResolveDeferred(const std::vector<Token>& tokens, std::shared_ptr<const OperationsSnapshot>& operations) {
+  bool resolved = false;
+  for (auto& token : tokens)
+    if (token.GetType() != Token::Type::VARIABLE && operations->IsDeferred(token.GetSymbol()))
+      resolved = OperationsDescription::GetInstance().Resolve(token.GetSymbol()) || resolved;
+  if (resolved)
+    operations = OperationsDescription::GetInstance().GetSnapshot();
+}
+
+/**
+* @brief function of adding expression to the end of program
+* @param[in/out] program - program
+* @param[in/out] operations - operations whose names are known
+* @param[in] expression - expression in string form
+*/
+void CompileExpression(CompiledExpression& program, std::shared_ptr<const OperationsSnapshot>& operations, const std::string& expression) {
+  std::vector<Token> separatedExpression;
+  Separate(expression, *operations, separatedExpression);
+  ResolveDeferred(separatedExpression, operations);
+  ExpressionParser(program, *operations, separatedExpression).Parse();
+}
+
+CompiledExpression Compile(const std::string& expression) {
+  std::shared_ptr<const OperationsSnapshot> operations = OperationsDescription::GetInstance().GetSnapshot();
+  return Compile(expression, operations);
+}
+
+CompiledExpression Compile(const std::string& expression, std::shared_ptr<const OperationsSnapshot>& operations) {
+  CompiledExpression program;
+  CompileExpression(program, operations, expression);
+  program.AddReturn();
+  return program;
+}
+
+CompiledExpression CompileFused(const std::vector<std::string>& expressions) {
+  if (expressions.empty())
+    throw std::runtime_error("No expressions");
+  CompiledExpression program;
+  std::shared_ptr<const OperationsSnapshot> operations = OperationsDescription::GetInstance().GetSnapshot();
+  for (size_t i = 0; i < expressions.size(); ++i) {
+    try {
+      CompileExpression(program, operations, expressions[i]);
+      if (i + 1 < expressions.size())
+        program.AddOutput();
+    }
+    catch (const std::exception& except) {
+      throw std::runtime_error(("Expression " + std::to_string(i + 1) + ": " + except.what()).c_str());
+    }
+  }
+  program.AddReturn();
+  return program;
+}
+
+std::string GetResultName(const std::string& expression) {
+  auto isLetter = [](char c) { return std::isalpha(static_cast<unsigned char>(c)) || c == '_'; };
+  size_t begin = expression.find_first_not_of(' ');
+  if (begin == std::string::npos || !isLetter(expression[begin]))
+    return "result";
+  size_t end = begin;
+  while (end < expression.size() && (isLetter(expression[end]) || std::isdigit(static_cast<unsigned char>(expression[end]))))
+    ++end;
+  size_t sign = expression.find_first_not_of(' ', end);
+  if (sign == std::string::npos || expression[sign] != '=' || (sign + 1 < expression.size() && expression[sign + 1] == '='))
+    return "result";
+  return expression.substr(begin, end - begin);
+}
+
+std::vector<std::string> GetResultNames(const std::vector<std::string>& expressions) {
+  std::vector<std::string> names;
+  for (size_t i = 0; i < expressions.size(); ++i) {
+    names.push_back(GetResultName(expressions[i]));
+    if (expressions.size() > 1 && names.back() == "result")
+      names.back() += std::to_string(i + 1);
+  }
+  return names;
+}
\ No newline at end of file
@@ -0,0 +1,472 @@
+#pragma once
+
+#include "../API/API.h"
+#include "../Separator/Separator.h"
+
+/**
+* @brief maximum depth of nested operands in expression, deeper expressions are rejected by parser
+*/
+constexpr size_t MAX_PARSE_DEPTH = 1000;
+
+/**
+* @brief class of expression compiled into a flat post-order program
+* @details the program is built once by Compile and may be evaluated many times with different variable values
+* @details while operations are added, pure operations with literal arguments are folded into literals,
+* identities x*1, 1*x, x/1, x-0 are removed and variables consumed by pure operations are loaded by value
+* @details when program is finished, it is treated as hash-consed DAG: structurally identical pure subexpressions
+* reading the same variables between the same side effects are computed once and their result is reused
+* @details several expressions may be compiled into one fused program, results of all of them except the last one
+* are stored to outputs and the last one is returned, so variables assigned by one expression are seen by next ones
+*/
+class CompiledExpression {
+public:
+  /**
+  * @brief enum class of program's instruction codes
+  */
+  enum class OpCode {
+    PUSH_LITERAL,     ///< push literal, argument is index in literal's pool
+    PUSH_VARIABLE,    ///< push variable, argument is variable's slot
+    LOAD_VARIABLE,    ///< push value of variable, argument is variable's slot
+    LOAD_TEMP,        ///< push shared result, argument is temporary's index
+    SAVE_TEMP,        ///< copy value on top of stack to temporary, argument is temporary's index
+    ADD,              ///< built-in addition
+    SUB,              ///< built-in subtraction
+    MUL,              ///< built-in multiplication
+    DIV,              ///< built-in division
+    ASSIGN,           ///< built-in assignment
+    NEG,              ///< built-in unary minus
+    PRE_INC,          ///< built-in prefics increment
+    PRE_DEC,          ///< built-in prefics decrement
+    POST_INC,         ///< built-in postfics increment
+    POST_DEC,         ///< built-in postfics decrement
+    MAX,              ///< built-in maximum of two arguments
+    CALL_BINARY,      ///< call of binary operator on values
+    CALL_UNARY,       ///< call of prefics, postfics or bracket operation on value
+    CALL_FUNC1,       ///< call of function of one argument
+    CALL_FUNC2,       ///< call of function of two arguments
+    CALL_FUNCN,       ///< call of function of any number of arguments, argument is the number of arguments
+    CALL_OPERATION,   ///< perform operation through Operation::DoOperation, argument is index in operation's pool
+    STORE_OUTPUT,     ///< pop value and store it to output, argument is output's index
+    RETURN,           ///< end of program, result is on top of stack
+  };
+
+  /**
+  * @brief function called by instruction
+  */
+  union Callback {
+    BinaryOperator::DoValueBinaryOperation binary;    ///< for CALL_BINARY
+    PreficsOperator::DoValuePreficsOperation unary;   ///< for CALL_UNARY
+    Function::DoUnaryFunc func1;                      ///< for CALL_FUNC1
+    Function::DoBinaryFunc func2;                     ///< for CALL_FUNC2
+    Function::DoSpanFunc funcN;                       ///< for CALL_FUNCN
+  };
+
+  /**
+  * @brief program's instruction
+  */
+  struct Instruction {
+    OpCode code;                                 ///< instruction code
+    size_t arg;                                  ///< instruction argument (index in pool, variable's slot or the number of arguments)
+    Callback callback = {};                      ///< called function for CALL_* instructions
+    bool pure = true;                            ///< false if instruction may have side effects
+    Operation::BatchKernel batch = nullptr;      ///< batch kernel of called function for CALL_* instructions, nullptr if there is no kernel
+  };
+
+  /**
+  * @brief default constructor
+  */
+  CompiledExpression() = default;
+
+  /**
+  * @brief default copy constructor
+  */
+  CompiledExpression(const CompiledExpression&) = default;
+
+  /**
+  * @brief default move constructor
+  */
+  CompiledExpression(CompiledExpression&&) = default;
+
+  /**
+  * @brief default copy operator
+  */
+  CompiledExpression& operator= (const CompiledExpression&) = default;
+
+  /**
+  * @brief default move operator
+  */
+  CompiledExpression& operator= (CompiledExpression&&) = default;
+
+  /**
+  * @brief default destructor
+  */
+  ~CompiledExpression() = default;
+
+  /**
+  * @brief method of adding the literal push to the end of program
+  * @param[in] value - literal value
+  */
+  void AddLiteral(double value);
+
+  /**
+  * @brief method of adding the variable push to the end of program
+  * @param[in] name - name of variable
+  * @param[in] symbol - id of name of variable in SymbolTable
+  */
+  void AddVariable(std::string_view name, uint32_t symbol);
+
+  /**
+  * @brief method of adding the operation call to the end of program
+  * @param[in] descriptor - descriptor of operation
+  * @throw std::exception if there are not enough operands for operation
+  */
+  void AddOperation(const OperationDescriptor& descriptor);
+
+  /**
+  * @brief method of finishing expression of fused program, its result is stored to the next output
+  * @throw std::exception if expression does not leave exactly one operand on stack
+  */
+  void AddOutput(void);
+
+  /**
+  * @brief method of finishing program, shares common subexpressions
+  * @throw std::exception if program does not leave exactly one operand on stack
+  */
+  void AddReturn(void);
+
+  /**
+  * @brief getter of program
+  * @return vector of instructions in post-order
+  */
+  const std::vector<Instruction>& GetProgram(void) const;
+
+  /**
+  * @brief getter of literal from literal's pool
+  * @param[in] index - index in pool
+  * @return literal value
+  */
+  double GetLiteral(size_t index) const;
+
+  /**
+  * @brief getter of operation from operation's pool
+  * @param[in] index - index in pool
+  * @return shared pointer to operation
+  */
+  const std::shared_ptr<Operation>& GetOperation(size_t index) const;
+
+  /**
+  * @brief getter of number of variable's slots
+  * @return number of different variables in expression
+  */
+  size_t GetVariablesCount(void) const;
+
+  /**
+  * @brief getter of variable's name
+  * @param[in] slot - variable's slot
+  * @return name of variable
+  */
+  const std::string& GetVariableName(size_t slot) const;
+
+  /**
+  * @brief getter of id of variable's name in SymbolTable
+  * @param[in] slot - variable's slot
+  * @return id of name of variable
+  */
+  uint32_t GetVariableSymbol(size_t slot) const;
+
+  /**
+  * @brief method of check availability of variable in expression
+  * @param[in] name - name of variable
+  * @return true if expression uses variable, false otherwise
+  */
+  bool CheckVariable(const std::string& name) const;
+
+  /**
+  * @brief getter of variable's slot
+  * @param[in] name - name of variable
+  * @return variable's slot
+  * @throw std::exception if expression does not use variable
+  */
+  size_t FindVariable(const std::string& name) const;
+
+  /**
+  * @brief getter of number of operands left on stack after program
+  * @return stack depth at the end of program
+  */
+  size_t GetDepth(void) const;
+
+  /**
+  * @brief getter of maximum stack depth reached by program
+  * @return maximum stack depth
+  */
+  size_t GetMaxDepth(void) const;
+
+  /**
+  * @brief getter of number of results of program
+  * @return number of expressions compiled into program
+  */
+  size_t GetOutputsCount(void) const;
+
+  /**
+  * @brief getter of number of temporaries holding shared results
+  * @return number of temporaries
+  */
+  size_t GetTempsCount(void) const;
+
+  /**
+  * @brief getter of number of operands popped by instruction
+  * @param[in] instruction - instruction
+  * @return number of arguments
+  */
+  size_t GetArgsNum(const Instruction& instruction) const;
+private:
+  /**
+  * @brief description of operand on stack during compilation
+  */
+  struct OperandInfo {
+    size_t start;   ///< index of the first instruction computing operand
+    bool pure;      ///< true if computing operand has no side effects
+  };
+
+  /**
+  * @brief method of accounting a push to the stack
+  * @param[in] start - index of the first instruction computing pushed operand
+  * @param[in] pure - true if computing operand has no side effects
+  */
+  void Push(size_t start, bool pure);
+
+  /**
+  * @brief method of check that operand is computed by single instruction
+  * @param[in] operand - index of operand on stack
+  * @param[in] code - instruction code
+  * @return true if operand is computed by single instruction with this code, false otherwise
+  */
+  bool IsSingle(size_t operand, OpCode code) const;
+
+  /**
+  * @brief method of computing pure operation with literal arguments at compile time
+  * @param[in] operation - operation
+  * @param[in] first - index of the first argument on stack
+  * @return true if operation is replaced with literal, false otherwise
+  */
+  bool Fold(const Operation& operation, size_t first);
+
+  /**
+  * @brief method of removing binary operation which does not change the other argument
+  * @details only identities which hold for every IEEE value are applied: x-0, x*1, 1*x and x/1
+  * @param[in] code - instruction code of operation
+  * @param[in] first - index of the first argument on stack
+  * @return true if operation is removed, false otherwise
+  */
+  bool Simplify(OpCode code, size_t first);
+
+  /**
+  * @brief method of replacing pushes of variables by loads of their values where it does not change the result
+  * @param[in] first - index of the first argument of pure operation on stack
+  */
+  void LoadVariables(size_t first);
+
+  /**
+  * @brief method of replacing repeated pure subexpressions by loads of the result of the first one
+  */
+  void Share(void);
+
+  /**
+  * @brief method of choosing instruction performing operation
+  * @param[in] operation - operation
+  * @return instruction, its argument is not set for CALL_OPERATION
+  */
+  static Instruction Lower(const Operation& operation);
+
+  /**
+  * @brief program in post-order
+  */
+  std::vector<Instruction> program;
+
+  /**
+  * @brief literal's pool
+  */
+  std::vector<double> literals;
+
+  /**
+  * @brief operation's pool
+  */
+  std::vector<std::shared_ptr<Operation>> operations;
+
+  /**
+  * @brief names of variables, index is variable's slot
+  */
+  std::vector<std::string> variables;
+
+  /**
+  * @brief ids of names of variables, index is variable's slot
+  */
+  std::vector<uint32_t> symbols;
+
+  /**
+  * @brief operands on stack at the end of program
+  */
+  std::vector<OperandInfo> operands;
+
+  /**
+  * @brief maximum stack depth
+  */
+  size_t maxDepth = 0;
+
+  /**
+  * @brief number of temporaries
+  */
+  size_t tempsCount = 0;
+
+  /**
+  * @brief number of results stored by STORE_OUTPUT
+  */
+  size_t storedCount = 0;
+};
+
+
+
+
+/**
+* @brief class of binding values to variable's slots of compiled expression
+* @details binding either owns variables or refers to variables stored outside, for example in EvaluationContext
+*/
+class VariableBinding {
+public:
+  /**
+  * @brief default consructor (deleted)
+  * @warning the method is deleted
+  */
+  VariableBinding() = delete;
+
+  /**
+  * @brief constructor, all variables are not init
+  * @param[in] expression - compiled expression whose variables are bound
+  */
+  VariableBinding(const CompiledExpression& expression);
+
+  /**
+  * @brief constructor, binds slots to variables stored outside
+  * @param[in] variables - pointers to variables, index is variable's slot
+  * @warning variables must outlive binding, assignments are made in them directly
+  */
+  VariableBinding(std::vector<Variable*> variables);
+
+  /**
+  * @brief copy constructor, copy of binding which owns variables owns copies of them
+  * @param[in] other - copied binding
+  */
+  VariableBinding(const VariableBinding& other);
+
+  /**
+  * @brief default move constructor
+  */
+  VariableBinding(VariableBinding&&) = default;
+
+  /**
+  * @brief copy operator, copy of binding which owns variables owns copies of them
+  * @param[in] other - copied binding
+  * @return this binding
+  */
+  VariableBinding& operator= (const VariableBinding& other);
+
+  /**
+  * @brief default move operator
+  */
+  VariableBinding& operator= (VariableBinding&&) = default;
+
+  /**
+  * @brief default destructor
+  */
+  ~VariableBinding() = default;
+
+  /**
+  * @brief setter value of variable
+  * @param[in] slot - variable's slot
+  * @param[in] value - new value of variable
+  */
+  void SetValue(size_t slot, double value);
+
+  /**
+  * @brief setter value of variable
+  * @param[in] name - name of variable
+  * @param[in] value - new value of variable
+  * @warning variables which are not used in expression are ignored
+  */
+  void SetValue(const std::string& name, double value);
+
+  /**
+  * @brief getter of variable
+  * @param[in] slot - variable's slot
+  * @return variable
+  */
+  const Variable& GetVariable(size_t slot) const;
+
+  /**
+  * @brief getter of variable
+  * @param[in] slot - variable's slot
+  * @return variable
+  */
+  Variable& GetVariable(size_t slot);
+
+  /**
+  * @brief getter of number of variable's slots
+  * @return number of variables
+  */
+  size_t GetVariablesCount(void) const;
+private:
+  /**
+  * @brief method of pointing slots to owned variables
+  */
+  void Rebind(void);
+
+  /**
+  * @brief owned variables, index is variable's slot, empty if variables are stored outside
+  */
+  std::vector<Variable> own;
+
+  /**
+  * @brief variables, index is variable's slot
+  */
+  std::vector<Variable*> slots;
+};
+
+/**
+* @brief expression compiling function
+* @param[in] expression - expression in string form
+* @return compiled expression
+*/
+CompiledExpression Compile(const std::string& expression);
+
+/**
+* @brief expression compiling function with pinned snapshot of operations
+* @details if expression uses deferred operations, their modules are loaded and the current snapshot is pinned instead
+* @param[in] expression - expression in string form
+* @param[in/out] operations - operations whose names are known
+* @return compiled expression
+*/
+CompiledExpression Compile(const std::string& expression, std::shared_ptr<const OperationsSnapshot>& operations);
+
+/**
+* @brief function of compiling expressions into one fused program
+* @details expressions are evaluated in order, they share variables and common subexpressions,
+* result of expression i is output i
+* @param[in] expressions - expressions in string form
+* @return compiled program
+* @throw std::exception if there are no expressions or any of them can not be compiled
+*/
+CompiledExpression CompileFused(const std::vector<std::string>& expressions);
+
+/**
+* @brief function of getting name of expression's result
+* @param[in] expression - expression in string form
+* @return name of assigned variable if expression starts with assignment, "result" otherwise
+*/
+std::string GetResultName(const std::string& expression);
+
+/**
+* @brief function of getting names of results of expressions
+* @param[in] expressions - expressions in string form
+* @return names given by GetResultName, results of several expressions which are not assignments are numbered from 1
+*/
+std::vector<std::string> GetResultNames(const std::vector<std::string>& expressions);
\ No newline at end of file
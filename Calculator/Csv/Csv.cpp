@@ -0,0 +1,436 @@
+#include "Csv.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+bool ParseNumber(const char* begin, const char* end, double& value) {
+  static const double POWERS[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+  const uint64_t MAX_EXACT = uint64_t(1) << 53;   //all integers up to it are exact doubles
+  const int MAX_DIGITS = 19;                      //digits which always fit uint64_t
+
+  while (begin < end && (*begin == ' ' || *begin == '\t'))
+    ++begin;
+  while (end > begin && (end[-1] == ' ' || end[-1] == '\t'))
+    --end;
+
+  const char* p = begin;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+'))
+    negative = *p++ == '-';
+  uint64_t mantissa = 0;
+  int digits = 0;       //significant digits in mantissa
+  int exponent = 0;
+  bool anyDigit = false;
+  bool truncated = false;
+  for (; p < end && unsigned(*p - '0') < 10; ++p) {
+    anyDigit = true;
+    if (mantissa == 0 && *p == '0')
+      continue;
+    if (digits == MAX_DIGITS) {
+      truncated = true;
+      ++exponent;
+      continue;
+    }
+    mantissa = mantissa * 10 + unsigned(*p - '0');
+    ++digits;
+  }
+  if (p < end && *p == '.')
+    for (++p; p < end && unsigned(*p - '0') < 10; ++p) {
+      anyDigit = true;
+      if (mantissa == 0 && *p == '0') {
+        --exponent;
+        continue;
+      }
+      if (digits == MAX_DIGITS) {
+        truncated = true;
+        continue;
+      }
+      mantissa = mantissa * 10 + unsigned(*p - '0');
+      ++digits;
+      --exponent;
+    }
+  if (anyDigit && p < end && (*p == 'e' || *p == 'E')) {
+    const char* exponentBegin = p++;
+    bool negativeExponent = false;
+    if (p < end && (*p == '-' || *p == '+'))
+      negativeExponent = *p++ == '-';
+    if (p == end || unsigned(*p - '0') >= 10)
+      p = exponentBegin;
+    else {
+      int written = 0;
+      for (; p < end && unsigned(*p - '0') < 10; ++p)
+        if (written < 100000)
+          written = written * 10 + (*p - '0');
+      exponent += negativeExponent ? -written : written;
+    }
+  }
+
+  if (anyDigit && p == end && !truncated && mantissa <= MAX_EXACT && exponent >= -22 && exponent <= 22) {
+    value = exponent < 0 ? double(mantissa) / POWERS[-exponent] : double(mantissa) * POWERS[exponent];
+    if (negative)
+      value = -value;
+    return true;
+  }
+  if (anyDigit && p == end && mantissa == 0) {
+    value = negative ? -0.0 : 0.0;
+    return true;
+  }
+
+  //long mantissas, big exponents, inf and nan
+  if (begin < end && *begin == '+')
+    ++begin;
+  auto result = std::from_chars(begin, end, value);
+  if (result.ptr != end || begin == end)
+    return false;
+  if (result.ec == std::errc::result_out_of_range) {
+    value = exponent > 0 ? HUGE_VAL : 0.0;
+    if (negative)
+      value = -value;
+  }
+  return result.ec == std::errc() || result.ec == std::errc::result_out_of_range;
+}
+
+CsvReader::CsvReader(const std::string& path) : buffer(CSV_READ_SIZE) {
+  file = std::fopen(path.c_str(), "rb");
+  if (file == nullptr)
+    throw std::runtime_error(("Cannot open file " + path).c_str());
+
+  const char* rowEnd;
+  while ((rowEnd = FindRowEnd(buffer.data() + dataBegin)) == nullptr)
+    Fill();
+  const char* rowBegin = buffer.data() + dataBegin;
+  if (rowEnd == rowBegin) {
+    std::fclose(file);
+    throw std::runtime_error(("No header in file " + path).c_str());
+  }
+  if (rowEnd - rowBegin >= 3 && std::memcmp(rowBegin, "\xEF\xBB\xBF", 3) == 0)
+    rowBegin += 3;
+  const char* lineEnd = rowEnd > rowBegin && rowEnd[-1] == '\r' ? rowEnd - 1 : rowEnd;
+  SplitRow(rowBegin, lineEnd, SIZE_MAX, [this](size_t, const char* begin, const char* end) {
+    while (begin < end && *begin == ' ')
+      ++begin;
+    while (end > begin && end[-1] == ' ')
+      --end;
+    header.emplace_back(begin, end);
+  });
+  dataBegin = rowEnd - buffer.data() + (rowEnd < buffer.data() + dataEnd ? 1 : 0);
+  rowsCount = 1;
+  targets.assign(header.size(), SIZE_MAX);
+}
+
+CsvReader::~CsvReader() {
+  std::fclose(file);
+}
+
+const std::vector<std::string>& CsvReader::GetHeader(void) const {
+  return header;
+}
+
+void CsvReader::SetTargets(std::vector<size_t> targets) {
+  this->targets = std::move(targets);
+  usedFields = 0;
+  for (size_t field = 0; field < this->targets.size(); ++field)
+    if (this->targets[field] != SIZE_MAX)
+      usedFields = field + 1;
+}
+
+size_t CsvReader::ReadRows(double* const* columns, size_t maxRows) {
+  size_t rows = 0;
+  while (rows < maxRows) {
+    const char* rowBegin = buffer.data() + dataBegin;
+    const char* rowEnd = FindRowEnd(rowBegin);
+    if (rowEnd == nullptr) {
+      Fill();
+      continue;
+    }
+    const char* dataEndPtr = buffer.data() + dataEnd;
+    if (rowBegin == dataEndPtr)
+      break;
+    dataBegin = rowEnd - buffer.data() + (rowEnd < dataEndPtr ? 1 : 0);
+    ++rowsCount;
+    const char* lineEnd = rowEnd > rowBegin && rowEnd[-1] == '\r' ? rowEnd - 1 : rowEnd;
+    //empty row is rejected, since skipping it would shift results against rows of file
+    if (lineEnd == rowBegin)
+      throw std::runtime_error(("Empty row " + std::to_string(rowsCount)).c_str());
+
+    size_t fieldsNum = SplitRow(rowBegin, lineEnd, usedFields, [&](size_t field, const char* begin, const char* end) {
+      size_t target = targets[field];
+      if (target != SIZE_MAX && !ParseNumber(begin, end, columns[target][rows]))
+        throw std::runtime_error(("Invalid number in row " + std::to_string(rowsCount) + ", column " + header[field]).c_str());
+    });
+    if (fieldsNum < usedFields)
+      throw std::runtime_error(("Not enough fields in row " + std::to_string(rowsCount)).c_str());
+    ++rows;
+  }
+  return rows;
+}
+
+bool CsvReader::Fill(void) {
+  if (eof)
+    return false;
+  if (dataBegin > 0) {
+    std::memmove(buffer.data(), buffer.data() + dataBegin, dataEnd - dataBegin);
+    dataEnd -= dataBegin;
+    dataBegin = 0;
+  }
+  //row which does not fit into buffer makes it bigger
+  if (buffer.size() - dataEnd < CSV_READ_SIZE / 2)
+    buffer.resize(buffer.size() + CSV_READ_SIZE);
+  size_t read = std::fread(buffer.data() + dataEnd, 1, buffer.size() - dataEnd, file);
+  if (std::ferror(file))
+    throw std::runtime_error("Cannot read CSV file");
+  dataEnd += read;
+  if (read == 0)
+    eof = true;
+  return read != 0;
+}
+
+const char* CsvReader::FindRowEnd(const char* begin) const {
+  const char* end = buffer.data() + dataEnd;
+  const char* lineFeed = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+  const char* rowEnd = lineFeed != nullptr ? lineFeed : end;
+  if (std::memchr(begin, '"', rowEnd - begin) != nullptr) {
+    //line feed inside quotes does not end row
+    bool quoted = false;
+    lineFeed = nullptr;
+    for (const char* p = begin; p < end; ++p)
+      if (*p == '"')
+        quoted = !quoted;
+      else if (*p == '\n' && !quoted) {
+        lineFeed = p;
+        break;
+      }
+  }
+  if (lineFeed != nullptr)
+    return lineFeed;
+  return eof ? end : nullptr;
+}
+
+template<typename OnField>
+size_t CsvReader::SplitRow(const char* begin, const char* end, size_t fieldsNum, OnField onField) const {
+  const char* p = begin;
+  for (size_t field = 0; field < fieldsNum; ++field) {
+    const char* fieldBegin = p;
+    const char* fieldEnd;
+    if (p < end && *p == '"') {
+      fieldBegin = ++p;
+      while (p < end && !(*p == '"' && (p + 1 == end || p[1] != '"')))
+        p += *p == '"' ? 2 : 1;
+      fieldEnd = p;
+      p = std::find(p, end, ',');
+    }
+    else {
+      p = std::find(p, end, ',');
+      fieldEnd = p;
+    }
+    onField(field, fieldBegin, fieldEnd);
+    if (p == end)
+      return field + 1;
+    ++p;
+  }
+  return fieldsNum;
+}
+
+CsvWriter::CsvWriter(const std::string& path, const std::vector<std::string>& names) : buffer(CSV_READ_SIZE), columnsCount(names.size()) {
+  file = std::fopen(path.c_str(), "wb");
+  if (file == nullptr)
+    throw std::runtime_error(("Cannot create file " + path).c_str());
+  std::string header;
+  for (auto& name : names)
+    header += (header.empty() ? "" : ",") + name;
+  header += '\n';
+  if (header.size() > buffer.size())
+    buffer.resize(header.size());
+  std::copy(header.begin(), header.end(), buffer.data());
+  size = header.size();
+}
+
+CsvWriter::~CsvWriter() {
+  std::fclose(file);
+}
+
+void CsvWriter::WriteRows(const double* const* columns, size_t rowsNum) {
+  const size_t MAX_NUMBER_SIZE = 32;
+  size_t maxRowSize = columnsCount * MAX_NUMBER_SIZE;
+  if (buffer.size() < maxRowSize)
+    buffer.resize(maxRowSize);
+  for (size_t row = 0; row < rowsNum; ++row) {
+    if (buffer.size() - size < maxRowSize)
+      Flush();
+    char* end = buffer.data() + size;
+    for (size_t column = 0; column < columnsCount; ++column) {
+      end = std::to_chars(end, end + MAX_NUMBER_SIZE - 1, columns[column][row]).ptr;
+      *end++ = column + 1 < columnsCount ? ',' : '\n';
+    }
+    size = end - buffer.data();
+  }
+}
+
+void CsvWriter::Flush(void) {
+  if (std::fwrite(buffer.data(), 1, size, file) != size || std::fflush(file) != 0)
+    throw std::runtime_error("Cannot write CSV file");
+  size = 0;
+}
+
+/**
+* @brief class of queue of block's indexes between pipeline's stages
+*/
+class BlockQueue {
+public:
+  /**
+  * @brief method of adding block, it is dropped if queue is closed
+  * @param[in] block - index of block
+  */
+  void Push(size_t block) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (closed)
+        return;
+      blocks.push_back(block);
+    }
+    ready.notify_one();
+  }
+
+  /**
+  * @brief method of taking block, waits until there is block or queue is closed
+  * @param[out] block - index of block
+  * @return false if queue is closed and empty, true otherwise
+  */
+  bool Pop(size_t& block) {
+    std::unique_lock<std::mutex> lock(mutex);
+    ready.wait(lock, [this] { return closed || !blocks.empty(); });
+    if (blocks.empty())
+      return false;
+    block = blocks.front();
+    blocks.pop_front();
+    return true;
+  }
+
+  /**
+  * @brief method of closing queue, waiting stages are woken up
+  */
+  void Close(void) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      closed = true;
+    }
+    ready.notify_all();
+  }
+private:
+  std::mutex mutex;                 ///< guard of queue
+  std::condition_variable ready;    ///< condition of new block or closing
+  std::deque<size_t> blocks;        ///< indexes of blocks
+  bool closed = false;              ///< flag of closed queue
+};
+
+size_t EvaluateCsv(const std::string& inputPath, const std::vector<std::string>& expressions, const std::string& outputPath, ThreadPool* pool) {
+  struct InputBlock {
+    std::vector<double> values;     //values of bound columns
+    std::vector<double*> columns;   //columns by variable's slots
+    size_t rows = 0;
+  };
+  struct OutputBlock {
+    std::vector<double> values;     //values of all outputs
+    std::vector<double*> columns;   //outputs by index
+    size_t rows = 0;
+  };
+
+  CompiledExpression expression = CompileFused(expressions);
+  CsvReader reader(inputPath);
+  const std::vector<std::string>& header = reader.GetHeader();
+  size_t variablesCount = expression.GetVariablesCount();
+  std::vector<size_t> targets(header.size(), SIZE_MAX);
+  std::vector<size_t> boundSlots;
+  for (size_t slot = 0; slot < variablesCount; ++slot) {
+    auto field = std::find(header.begin(), header.end(), expression.GetVariableName(slot));
+    if (field != header.end() && targets[field - header.begin()] == SIZE_MAX) {
+      targets[field - header.begin()] = slot;
+      boundSlots.push_back(slot);
+    }
+  }
+  reader.SetTargets(std::move(targets));
+  CsvWriter writer(outputPath, GetResultNames(expressions));
+
+  std::vector<InputBlock> inputs(CSV_PIPELINE_DEPTH);
+  std::vector<OutputBlock> outputs(CSV_PIPELINE_DEPTH);
+  BlockQueue inputFree, inputFull, outputFree, outputFull;
+  for (size_t i = 0; i < CSV_PIPELINE_DEPTH; ++i) {
+    inputs[i].values.resize(boundSlots.size() * CSV_BLOCK_ROWS);
+    inputs[i].columns.assign(variablesCount, nullptr);
+    for (size_t j = 0; j < boundSlots.size(); ++j)
+      inputs[i].columns[boundSlots[j]] = inputs[i].values.data() + j * CSV_BLOCK_ROWS;
+    outputs[i].values.resize(expressions.size() * CSV_BLOCK_ROWS);
+    for (size_t j = 0; j < expressions.size(); ++j)
+      outputs[i].columns.push_back(outputs[i].values.data() + j * CSV_BLOCK_ROWS);
+    inputFree.Push(i);
+    outputFree.Push(i);
+  }
+
+  std::exception_ptr readError, evaluateError, writeError;
+  std::thread readThread([&] {
+    try {
+      size_t block;
+      while (inputFree.Pop(block)) {
+        inputs[block].rows = reader.ReadRows(inputs[block].columns.data(), CSV_BLOCK_ROWS);
+        if (inputs[block].rows == 0)
+          break;
+        inputFull.Push(block);
+      }
+    }
+    catch (...) {
+      readError = std::current_exception();
+    }
+    inputFull.Close();
+  });
+  std::thread writeThread([&] {
+    try {
+      size_t block;
+      while (outputFull.Pop(block)) {
+        writer.WriteRows(outputs[block].columns.data(), outputs[block].rows);
+        outputFree.Push(block);
+      }
+      writer.Flush();
+    }
+    catch (...) {
+      writeError = std::current_exception();
+      outputFree.Close();
+    }
+  });
+
+  size_t rowsCount = 0;
+  try {
+    size_t input, output;
+    while (inputFull.Pop(input) && outputFree.Pop(output)) {
+      const InputBlock& in = inputs[input];
+      OutputBlock& out = outputs[output];
+      if (pool != nullptr)
+        EvaluateFusedBatch(expression, in.columns.data(), in.rows, out.columns.data(), *pool);
+      else
+        EvaluateFusedBatch(expression, in.columns.data(), in.rows, out.columns.data());
+      out.rows = in.rows;
+      rowsCount += in.rows;
+      inputFree.Push(input);
+      outputFull.Push(output);
+    }
+  }
+  catch (...) {
+    evaluateError = std::current_exception();
+  }
+  inputFree.Close();
+  outputFull.Close();
+  readThread.join();
+  writeThread.join();
+
+  for (auto& error : { readError, evaluateError, writeError })
+    if (error)
+      std::rethrow_exception(error);
+  return rowsCount;
+}
\ No newline at end of file
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "../Interpreter/Interpreter.h"
+#include <cstdio>
+
+/**
+* @brief number of rows which are read, evaluated and written as one block by EvaluateCsv
+*/
+constexpr size_t CSV_BLOCK_ROWS = 64 * BATCH_SIZE;
+
+/**
+* @brief number of bytes read from CSV file at once
+*/
+constexpr size_t CSV_READ_SIZE = 1 << 20;
+
+/**
+* @brief number of blocks of each kind which are in flight between stages of EvaluateCsv
+*/
+constexpr size_t CSV_PIPELINE_DEPTH = 3;
+
+/**
+* @brief number parsing function
+* @details decimal numbers with up to 19 significant digits and decimal exponent up to 22 are converted exactly
+* by one multiplication or division, other ones are passed to std::from_chars, spaces around number are skipped
+* @param[in] begin - begin of text
+* @param[in] end - end of text
+* @param[out] value - parsed number
+* @return true if the whole text is a number, false otherwise
+*/
+bool ParseNumber(const char* begin, const char* end, double& value);
+
+/**
+* @brief class of CSV file reader which parses selected columns into blocks of numbers
+* @details file is read by chunks of CSV_READ_SIZE bytes, so memory does not depend on file size,
+* the first row is header with names of columns, fields may be quoted
+*/
+class CsvReader {
+public:
+  /**
+  * @brief default consructor (deleted)
+  * @warning the method is deleted
+  */
+  CsvReader() = delete;
+
+  /**
+  * @brief constructor, opens file and reads header
+  * @param[in] path - path to file
+  * @throw std::exception if file can not be opened or has no header
+  */
+  explicit CsvReader(const std::string& path);
+
+  /**
+  * @brief copy consructor (deleted)
+  * @warning the method is deleted
+  */
+  CsvReader(const CsvReader&) = delete;
+
+  /**
+  * @brief copy operator (deleted)
+  * @warning the operator is deleted
+  */
+  CsvReader& operator=(const CsvReader&) = delete;
+
+  /**
+  * @brief destructor, closes file
+  */
+  ~CsvReader();
+
+  /**
+  * @brief getter of names of columns
+  * @return names of columns
+  */
+  const std::vector<std::string>& GetHeader(void) const;
+
+  /**
+  * @brief method of selecting columns which are parsed
+  * @param[in] targets - for every column of file index of target array in ReadRows or SIZE_MAX if column is skipped
+  */
+  void SetTargets(std::vector<size_t> targets);
+
+  /**
+  * @brief method of reading rows
+  * @param[out] columns - target arrays of selected columns, each of them has place for maxRows numbers
+  * @param[in] maxRows - maximum number of rows
+  * @return number of read rows, 0 at the end of file
+  * @throw std::exception if file can not be read, row is empty, row has not enough fields or selected field is not a number
+  */
+  size_t ReadRows(double* const* columns, size_t maxRows);
+private:
+  /**
+  * @brief method of reading more data into buffer
+  * @return false if nothing is read because of end of file, true otherwise
+  */
+  bool Fill(void);
+
+  /**
+  * @brief method of searching end of row
+  * @param[in] begin - begin of row
+  * @return position of line feed which ends row or end of data, nullptr if row is not complete in buffer
+  */
+  const char* FindRowEnd(const char* begin) const;
+
+  /**
+  * @brief method of splitting row into fields
+  * @param[in] begin - begin of row
+  * @param[in] end - end of row without line feed
+  * @param[in] fieldsNum - number of first fields which are split, the rest of row is skipped
+  * @param[in] onField - function called with index, begin and end of every field without quotes
+  * @return number of split fields
+  */
+  template<typename OnField>
+  size_t SplitRow(const char* begin, const char* end, size_t fieldsNum, OnField onField) const;
+
+  /**
+  * @brief file
+  */
+  std::FILE* file = nullptr;
+
+  /**
+  * @brief buffer of read data
+  */
+  std::vector<char> buffer;
+
+  /**
+  * @brief begin of not parsed data in buffer
+  */
+  size_t dataBegin = 0;
+
+  /**
+  * @brief end of read data in buffer
+  */
+  size_t dataEnd = 0;
+
+  /**
+  * @brief flag of end of file
+  */
+  bool eof = false;
+
+  /**
+  * @brief number of parsed rows including header
+  */
+  size_t rowsCount = 0;
+
+  /**
+  * @brief names of columns
+  */
+  std::vector<std::string> header;
+
+  /**
+  * @brief indexes of target arrays of columns
+  */
+  std::vector<size_t> targets;
+
+  /**
+  * @brief number of first fields which contain all selected columns
+  */
+  size_t usedFields = 0;
+};
+
+
+
+
+/**
+* @brief class of CSV file writer of columns of numbers
+* @details numbers are written in the shortest form which is read back exactly, data is written by chunks of CSV_READ_SIZE bytes
+*/
+class CsvWriter {
+public:
+  /**
+  * @brief default consructor (deleted)
+  * @warning the method is deleted
+  */
+  CsvWriter() = delete;
+
+  /**
+  * @brief constructor, creates file and writes header
+  * @param[in] path - path to file
+  * @param[in] names - names of columns
+  * @throw std::exception if file can not be created
+  */
+  CsvWriter(const std::string& path, const std::vector<std::string>& names);
+
+  /**
+  * @brief copy consructor (deleted)
+  * @warning the method is deleted
+  */
+  CsvWriter(const CsvWriter&) = delete;
+
+  /**
+  * @brief copy operator (deleted)
+  * @warning the operator is deleted
+  */
+  CsvWriter& operator=(const CsvWriter&) = delete;
+
+  /**
+  * @brief destructor, closes file
+  * @warning data which is not flushed is lost
+  */
+  ~CsvWriter();
+
+  /**
+  * @brief method of writing numbers
+  * @param[in] columns - arrays of numbers of every column
+  * @param[in] rowsNum - number of rows
+  * @throw std::exception if file can not be written
+  */
+  void WriteRows(const double* const* columns, size_t rowsNum);
+
+  /**
+  * @brief method of writing buffered data to file
+  * @throw std::exception if file can not be written
+  */
+  void Flush(void);
+private:
+  /**
+  * @brief file
+  */
+  std::FILE* file = nullptr;
+
+  /**
+  * @brief buffer of data which is not written
+  */
+  std::vector<char> buffer;
+
+  /**
+  * @brief size of data in buffer
+  */
+  size_t size = 0;
+
+  /**
+  * @brief number of columns
+  */
+  size_t columnsCount = 0;
+};
+
+/**
+* @brief function of evaluating expressions for every row of CSV file
+* @details expressions are compiled into one fused program, its variables are bound to columns with the same names,
+* file is processed by three threads: reader parses blocks of CSV_BLOCK_ROWS rows, evaluator runs EvaluateFusedBatch over them
+* and writer formats results, there are CSV_PIPELINE_DEPTH input and CSV_PIPELINE_DEPTH output blocks which are reused,
+* so memory does not depend on file size. Output file has column for every expression named by GetResultNames
+* @param[in] inputPath - path to input CSV file
+* @param[in] expressions - expressions
+* @param[in] outputPath - path to output CSV file
+* @param[in] pool - thread pool which evaluates blocks, nullptr to evaluate on evaluator thread
+* @return number of rows
+* @throw std::exception if files can not be read or written, expression can not be compiled or evaluating of any row fails
+*/
+size_t EvaluateCsv(const std::string& inputPath, const std::vector<std::string>& expressions, const std::string& outputPath, ThreadPool* pool);
\ No newline at end of file
@@ -0,0 +1,549 @@
+#include "Interpreter.h"
+#include "../BaseOperations/BaseOperation.h"
+#include "../VectorMath/VectorMath.h"
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__GNUC__)
+#define DISPATCH_TABLE
+#endif
+
+#ifdef DISPATCH_TABLE
+#define VM_LOOP goto *labels[static_cast<size_t>(ip->code)];
+#define VM_CASE(code) code##_LABEL
+#define VM_NEXT goto *labels[static_cast<size_t>((++ip)->code)]
+#else
+#define VM_LOOP for (;;) switch (ip->code)
+#define VM_CASE(code) case OpCode::code
+#define VM_NEXT ++ip; continue
+#endif
+
+double Evaluate(const CompiledExpression& expression, VariableBinding& binding) {
+  return Evaluate(expression, binding, nullptr);
+}
+
+double Evaluate(const CompiledExpression& expression, VariableBinding& binding, double* outputs) {
+  using OpCode = CompiledExpression::OpCode;
+
+  //temporaries are kept below the stack
+  Value localStorage[EVALUATE_STACK_SIZE];
+  std::vector<Value> heapStorage;
+  Value* temps = localStorage;
+  size_t required = expression.GetTempsCount() + expression.GetMaxDepth();
+  if (required > EVALUATE_STACK_SIZE) {
+    heapStorage.resize(required);
+    temps = heapStorage.data();
+  }
+  Value* storage = temps + expression.GetTempsCount();
+  size_t capacity = (heapStorage.empty() ? EVALUATE_STACK_SIZE : required) - expression.GetTempsCount();
+
+#ifdef DISPATCH_TABLE
+  static const void* const labels[] = {
+    &&PUSH_LITERAL_LABEL, &&PUSH_VARIABLE_LABEL, &&LOAD_VARIABLE_LABEL, &&LOAD_TEMP_LABEL, &&SAVE_TEMP_LABEL,
+    &&ADD_LABEL, &&SUB_LABEL, &&MUL_LABEL, &&DIV_LABEL, &&ASSIGN_LABEL,
+    &&NEG_LABEL, &&PRE_INC_LABEL, &&PRE_DEC_LABEL, &&POST_INC_LABEL, &&POST_DEC_LABEL, &&MAX_LABEL,
+    &&CALL_BINARY_LABEL, &&CALL_UNARY_LABEL, &&CALL_FUNC1_LABEL, &&CALL_FUNC2_LABEL, &&CALL_FUNCN_LABEL,
+    &&CALL_OPERATION_LABEL, &&STORE_OUTPUT_LABEL, &&RETURN_LABEL
+  };
+  static_assert(sizeof(labels) / sizeof(labels[0]) == static_cast<size_t>(OpCode::RETURN) + 1, "Dispatch table does not match OpCode");
+#endif
+
+  const CompiledExpression::Instruction* ip = expression.GetProgram().data();
+  Value* sp = storage;
+
+  VM_LOOP {
+  VM_CASE(PUSH_LITERAL): {
+    *sp++ = expression.GetLiteral(ip->arg);
+    VM_NEXT;
+  }
+  VM_CASE(PUSH_VARIABLE): {
+    *sp++ = Value(&binding.GetVariable(ip->arg));
+    VM_NEXT;
+  }
+  VM_CASE(LOAD_VARIABLE): {
+    *sp++ = binding.GetVariable(ip->arg).GetValue();
+    VM_NEXT;
+  }
+  VM_CASE(LOAD_TEMP): {
+    *sp++ = temps[ip->arg];
+    VM_NEXT;
+  }
+  VM_CASE(SAVE_TEMP): {
+    temps[ip->arg] = sp[-1].GetValue();
+    VM_NEXT;
+  }
+  VM_CASE(ADD): {
+    sp[-2] = sp[-2].GetValue() + sp[-1].GetValue();
+    --sp;
+    VM_NEXT;
+  }
+  VM_CASE(SUB): {
+    sp[-2] = sp[-2].GetValue() - sp[-1].GetValue();
+    --sp;
+    VM_NEXT;
+  }
+  VM_CASE(MUL): {
+    sp[-2] = sp[-2].GetValue() * sp[-1].GetValue();
+    --sp;
+    VM_NEXT;
+  }
+  VM_CASE(DIV): {
+    sp[-2] = sp[-2].GetValue() / sp[-1].GetValue();
+    --sp;
+    VM_NEXT;
+  }
+  VM_CASE(ASSIGN): {
+    sp[-2] = Assign(sp[-2], sp[-1]);
+    --sp;
+    VM_NEXT;
+  }
+  VM_CASE(NEG): {
+    sp[-1] = -sp[-1].GetValue();
+    VM_NEXT;
+  }
+  VM_CASE(PRE_INC): {
+    sp[-1] = PrefixIncrement(sp[-1]);
+    VM_NEXT;
+  }
+  VM_CASE(PRE_DEC): {
+    sp[-1] = PrefixDecrement(sp[-1]);
+    VM_NEXT;
+  }
+  VM_CASE(POST_INC): {
+    sp[-1] = PostfixIncrement(sp[-1]);
+    VM_NEXT;
+  }
+  VM_CASE(POST_DEC): {
+    sp[-1] = PostfixDecrement(sp[-1]);
+    VM_NEXT;
+  }
+  VM_CASE(MAX): {
+    double a = sp[-2].GetValue();
+    double b = sp[-1].GetValue();
+    sp[-2] = a > b ? a : b;
+    --sp;
+    VM_NEXT;
+  }
+  VM_CASE(CALL_BINARY): {
+    sp[-2] = ip->callback.binary(sp[-2], sp[-1]);
+    --sp;
+    VM_NEXT;
+  }
+  VM_CASE(CALL_UNARY): {
+    sp[-1] = ip->callback.unary(sp[-1]);
+    VM_NEXT;
+  }
+  VM_CASE(CALL_FUNC1): {
+    sp[-1] = ip->callback.func1(sp[-1].GetValue());
+    VM_NEXT;
+  }
+  VM_CASE(CALL_FUNC2): {
+    sp[-2] = ip->callback.func2(sp[-2].GetValue(), sp[-1].GetValue());
+    --sp;
+    VM_NEXT;
+  }
+  VM_CASE(CALL_FUNCN): {
+    size_t argsNum = ip->arg;
+    double localArgs[EVALUATE_STACK_SIZE];
+    std::vector<double> heapArgs;
+    double* args = localArgs;
+    if (argsNum > EVALUATE_STACK_SIZE) {
+      heapArgs.resize(argsNum);
+      args = heapArgs.data();
+    }
+    for (size_t i = 0; i < argsNum; ++i)
+      args[i] = sp[i - argsNum].GetValue();
+    sp -= argsNum;
+    *sp++ = ip->callback.funcN(args, argsNum);
+    VM_NEXT;
+  }
+  VM_CASE(CALL_OPERATION): {
+    Operation::DataStack dataStack(storage, capacity, sp - storage);
+    expression.GetOperation(ip->arg)->DoOperation(dataStack);
+    sp = storage + dataStack.size();
+    VM_NEXT;
+  }
+  VM_CASE(STORE_OUTPUT): {
+    if (outputs != nullptr)
+      outputs[ip->arg] = sp[-1].GetValue();
+    --sp;
+    VM_NEXT;
+  }
+  VM_CASE(RETURN): {
+    double result = sp[-1].GetValue();
+    if (outputs != nullptr)
+      outputs[expression.GetOutputsCount() - 1] = result;
+    return result;
+  }
+  }
+}
+
+/**
+* @brief function of check that program can be executed over blocks of rows
+* @param[in] expression - compiled expression
+* @param[out] written - flags of variables which may be changed by program
+* @return true if program is supported, false otherwise
+*/
+bool IsBatchSupported(const CompiledExpression& expression, std::vector<bool>& written) {
+  using OpCode = CompiledExpression::OpCode;
+
+  std::vector<bool> references;   //true for operands which are references to variables
+  written.assign(expression.GetVariablesCount(), false);
+  for (auto& instruction : expression.GetProgram()) {
+    switch (instruction.code) {
+    case OpCode::PUSH_VARIABLE:
+      written[instruction.arg] = true;
+      references.push_back(true);
+      continue;
+    case OpCode::CALL_OPERATION:
+      return false;
+    case OpCode::CALL_BINARY:
+    case OpCode::CALL_UNARY:
+      //value operations may change variables through references
+      for (size_t i = references.size() - expression.GetArgsNum(instruction); i < references.size(); ++i)
+        if (references[i])
+          return false;
+      break;
+    case OpCode::STORE_OUTPUT:
+      references.pop_back();
+      continue;
+    case OpCode::SAVE_TEMP:
+    case OpCode::RETURN:
+      continue;
+    default:
+      break;
+    }
+    references.resize(references.size() - expression.GetArgsNum(instruction));
+    references.push_back(false);
+  }
+  return true;
+}
+
+/**
+* @brief function of evaluating rows one at a time
+* @param[in] expression - compiled expression
+* @param[in] columns - values of variables
+* @param[in] begin - first row
+* @param[in] end - row after the last one
+* @param[out] outputs - arrays of stored results or nullptr
+* @param[out] out - array of returned results
+*/
+void EvaluateRows(const CompiledExpression& expression, const double* const* columns, size_t begin, size_t end,
+                  double* const* outputs, double* out) {
+  size_t variablesCount = expression.GetVariablesCount();
+  size_t storedCount = expression.GetOutputsCount() - 1;
+  VariableBinding initial(expression);
+  VariableBinding binding(initial);
+  std::vector<double> rowOutputs(storedCount + 1);
+  for (size_t row = begin; row < end; ++row) {
+    for (size_t slot = 0; slot < variablesCount; ++slot)
+      if (columns[slot] != nullptr)
+        binding.SetValue(slot, columns[slot][row]);
+      else
+        binding.GetVariable(slot) = initial.GetVariable(slot);
+    out[row] = Evaluate(expression, binding, rowOutputs.data());
+    if (outputs != nullptr)
+      for (size_t i = 0; i < storedCount; ++i)
+        outputs[i][row] = rowOutputs[i];
+  }
+}
+
+/**
+* @brief struct of memory used by EvaluateBlocks, it is allocated once and reused by following calls
+*/
+struct BatchScratch {
+  /**
+  * @brief struct of operand which is a block of values
+  */
+  struct Operand {
+    const double* values;   ///< values of block
+    size_t slot;            ///< slot of variable which operand refers to, SIZE_MAX if operand is not a reference
+  };
+
+  std::vector<double> storage;              ///< blocks of stack, temporaries and written variables
+  std::vector<Operand> stack;               ///< data stack
+  std::vector<const double*> variables;     ///< blocks of variables
+  std::vector<bool> init;                   ///< flags of init variables
+  std::vector<const double*> argColumns;    ///< arguments of CALL_FUNCN
+  std::vector<double> args;                 ///< arguments of CALL_FUNCN for one row
+
+  /**
+  * @brief method of allocating memory for expression
+  * @param[in] expression - compiled expression
+  */
+  void Reserve(const CompiledExpression& expression) {
+    size_t variablesCount = expression.GetVariablesCount();
+    storage.resize((expression.GetMaxDepth() + expression.GetTempsCount() + variablesCount) * BATCH_SIZE);
+    stack.resize(expression.GetMaxDepth());
+    variables.resize(variablesCount);
+    init.resize(variablesCount);
+  }
+};
+
+/**
+* @brief function of evaluating rows over blocks of BATCH_SIZE rows
+* @param[in] expression - compiled expression, it must be supported by IsBatchSupported
+* @param[in] written - flags of variables which may be changed by program
+* @param[in] columns - values of variables
+* @param[in] begin - first row
+* @param[in] end - row after the last one
+* @param[out] outputs - arrays of stored results or nullptr
+* @param[out] out - array of returned results
+* @param[in/out] scratch - memory reserved for expression
+*/
+void EvaluateBlocks(const CompiledExpression& expression, const std::vector<bool>& written, const double* const* columns,
+                    size_t begin, size_t end, double* const* outputs, double* out, BatchScratch& scratch) {
+  using OpCode = CompiledExpression::OpCode;
+  using Operand = BatchScratch::Operand;
+  const size_t NONE = SIZE_MAX;   //slot of operand which is not a reference
+
+  size_t variablesCount = expression.GetVariablesCount();
+  size_t maxDepth = expression.GetMaxDepth();
+  double* stackBlocks = scratch.storage.data();
+  double* tempBlocks = stackBlocks + maxDepth * BATCH_SIZE;
+  double* variableBlocks = tempBlocks + expression.GetTempsCount() * BATCH_SIZE;
+  std::vector<Operand>& stack = scratch.stack;
+  std::vector<const double*>& variables = scratch.variables;
+  std::vector<bool>& init = scratch.init;
+  std::vector<const double*>& argColumns = scratch.argColumns;
+  std::vector<double>& args = scratch.args;
+  const VectorKernels& kernels = GetVectorKernels();
+
+  for (size_t firstRow = begin; firstRow < end; firstRow += BATCH_SIZE) {
+    size_t n = std::min(BATCH_SIZE, end - firstRow);
+    for (size_t slot = 0; slot < variablesCount; ++slot) {
+      init[slot] = columns[slot] != nullptr;
+      if (written[slot]) {
+        double* block = variableBlocks + slot * BATCH_SIZE;
+        if (init[slot])
+          std::copy_n(columns[slot] + firstRow, n, block);
+        variables[slot] = block;
+      }
+      else
+        variables[slot] = init[slot] ? columns[slot] + firstRow : nullptr;
+    }
+
+    auto check = [&](size_t slot) {
+      if (!init[slot])
+        throw std::runtime_error(("Variable " + expression.GetVariableName(slot) + " not init").c_str());
+    };
+    auto read = [&](const Operand& operand) {
+      if (operand.slot != NONE)
+        check(operand.slot);
+      return operand.values;
+    };
+    auto variable = [&](const Operand& operand) {
+      if (operand.slot == NONE)
+        throw std::runtime_error("Cannot apply increment to constant");
+      check(operand.slot);
+      return variableBlocks + operand.slot * BATCH_SIZE;
+    };
+
+    size_t depth = 0;
+    for (auto& instruction : expression.GetProgram()) {
+      double* result = stackBlocks + (depth == 0 ? 0 : depth - 1) * BATCH_SIZE;
+      switch (instruction.code) {
+      case OpCode::PUSH_LITERAL: {
+        double* block = stackBlocks + depth * BATCH_SIZE;
+        std::fill_n(block, n, expression.GetLiteral(instruction.arg));
+        stack[depth++] = { block, NONE };
+        break;
+      }
+      case OpCode::PUSH_VARIABLE:
+        stack[depth++] = { variables[instruction.arg], instruction.arg };
+        break;
+      case OpCode::LOAD_VARIABLE:
+        check(instruction.arg);
+        if (written[instruction.arg]) {
+          //value is copied like in Evaluate, since the program may change the variable later
+          double* block = stackBlocks + depth * BATCH_SIZE;
+          std::copy_n(variables[instruction.arg], n, block);
+          stack[depth++] = { block, NONE };
+        }
+        else
+          stack[depth++] = { variables[instruction.arg], NONE };
+        break;
+      case OpCode::LOAD_TEMP:
+        stack[depth++] = { tempBlocks + instruction.arg * BATCH_SIZE, NONE };
+        break;
+      case OpCode::SAVE_TEMP:
+        std::copy_n(read(stack[depth - 1]), n, tempBlocks + instruction.arg * BATCH_SIZE);
+        break;
+      case OpCode::ADD:
+      case OpCode::SUB:
+      case OpCode::MUL:
+      case OpCode::DIV:
+      case OpCode::MAX:
+      case OpCode::CALL_BINARY:
+      case OpCode::CALL_FUNC2: {
+        const double* a = read(stack[depth - 2]);
+        const double* b = read(stack[depth - 1]);
+        result -= BATCH_SIZE;
+        switch (instruction.code) {
+        case OpCode::ADD:
+          kernels.add(a, b, result, n);
+          break;
+        case OpCode::SUB:
+          kernels.sub(a, b, result, n);
+          break;
+        case OpCode::MUL:
+          kernels.mul(a, b, result, n);
+          break;
+        case OpCode::DIV:
+          kernels.div(a, b, result, n);
+          break;
+        case OpCode::MAX:
+          kernels.max(a, b, result, n);
+          break;
+        default:
+          if (instruction.batch != nullptr) {
+            const double* batchArgs[] = { a, b };
+            instruction.batch(batchArgs, result, n);
+          }
+          else if (instruction.code == OpCode::CALL_BINARY)
+            for (size_t i = 0; i < n; ++i)
+              result[i] = instruction.callback.binary(a[i], b[i]);
+          else
+            for (size_t i = 0; i < n; ++i)
+              result[i] = instruction.callback.func2(a[i], b[i]);
+          break;
+        }
+        stack[--depth - 1] = { result, NONE };
+        break;
+      }
+      case OpCode::ASSIGN: {
+        if (stack[depth - 2].slot == NONE)
+          throw std::runtime_error("Impossible to assign a value to a non-variable");
+        const double* b = read(stack[depth - 1]);
+        double* a = variableBlocks + stack[depth - 2].slot * BATCH_SIZE;
+        result -= BATCH_SIZE;
+        for (size_t i = 0; i < n; ++i)
+          a[i] = b[i];
+        std::copy_n(a, n, result);
+        init[stack[depth - 2].slot] = true;
+        stack[--depth - 1] = { result, NONE };
+        break;
+      }
+      case OpCode::NEG:
+      case OpCode::CALL_UNARY:
+      case OpCode::CALL_FUNC1: {
+        const double* a = read(stack[depth - 1]);
+        if (instruction.code == OpCode::NEG)
+          kernels.neg(a, result, n);
+        else if (instruction.batch != nullptr)
+          instruction.batch(&a, result, n);
+        else if (instruction.code == OpCode::CALL_UNARY)
+          for (size_t i = 0; i < n; ++i)
+            result[i] = instruction.callback.unary(a[i]);
+        else
+          for (size_t i = 0; i < n; ++i)
+            result[i] = instruction.callback.func1(a[i]);
+        stack[depth - 1] = { result, NONE };
+        break;
+      }
+      case OpCode::PRE_INC:
+      case OpCode::PRE_DEC:
+      case OpCode::POST_INC:
+      case OpCode::POST_DEC: {
+        double* a = variable(stack[depth - 1]);
+        double step = instruction.code == OpCode::PRE_INC || instruction.code == OpCode::POST_INC ? 1 : -1;
+        bool prefics = instruction.code == OpCode::PRE_INC || instruction.code == OpCode::PRE_DEC;
+        for (size_t i = 0; i < n; ++i) {
+          result[i] = prefics ? a[i] + step : a[i];
+          a[i] += step;
+        }
+        stack[depth - 1] = { result, NONE };
+        break;
+      }
+      case OpCode::CALL_FUNCN: {
+        size_t argsNum = instruction.arg;
+        argColumns.resize(argsNum);
+        args.resize(argsNum);
+        for (size_t j = 0; j < argsNum; ++j)
+          argColumns[j] = read(stack[depth - argsNum + j]);
+        depth -= argsNum;
+        result = stackBlocks + depth * BATCH_SIZE;
+        if (instruction.batch != nullptr)
+          instruction.batch(argColumns.data(), result, n);
+        else
+          for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < argsNum; ++j)
+              args[j] = argColumns[j][i];
+            result[i] = instruction.callback.funcN(args.data(), argsNum);
+          }
+        stack[depth++] = { result, NONE };
+        break;
+      }
+      case OpCode::STORE_OUTPUT:
+        if (outputs != nullptr)
+          std::copy_n(read(stack[depth - 1]), n, outputs[instruction.arg] + firstRow);
+        else
+          read(stack[depth - 1]);
+        --depth;
+        break;
+      case OpCode::RETURN:
+        std::copy_n(read(stack[depth - 1]), n, out + firstRow);
+        break;
+      default:
+        break;
+      }
+    }
+  }
+}
+
+/**
+* @brief function of evaluating many rows on calling thread or on thread pool
+* @param[in] expression - compiled expression
+* @param[in] columns - values of variables
+* @param[in] rowsNum - number of rows
+* @param[out] outputs - arrays of stored results or nullptr
+* @param[out] out - array of returned results
+* @param[in] pool - thread pool or nullptr
+*/
+void RunBatch(const CompiledExpression& expression, const double* const* columns, size_t rowsNum,
+              double* const* outputs, double* out, ThreadPool* pool) {
+  std::vector<bool> written;
+  bool supported = IsBatchSupported(expression, written);
+  size_t threadsCount = pool != nullptr ? pool->GetThreadsCount() : 1;
+  //several ranges per worker let idle workers steal from the slow ones
+  size_t blocksNum = (rowsNum + BATCH_SIZE - 1) / BATCH_SIZE;
+  size_t grain = std::max<size_t>(1, blocksNum / (threadsCount * PARALLEL_RANGES_PER_THREAD)) * BATCH_SIZE;
+  if (threadsCount == 1 || rowsNum <= grain) {
+    if (!supported) {
+      EvaluateRows(expression, columns, 0, rowsNum, outputs, out);
+      return;
+    }
+    BatchScratch scratch;
+    scratch.Reserve(expression);
+    EvaluateBlocks(expression, written, columns, 0, rowsNum, outputs, out, scratch);
+    return;
+  }
+
+  std::vector<BatchScratch> scratches(threadsCount);
+  pool->ParallelFor(rowsNum, grain, [&](size_t worker, size_t begin, size_t end) {
+    if (!supported) {
+      EvaluateRows(expression, columns, begin, end, outputs, out);
+      return;
+    }
+    BatchScratch& scratch = scratches[worker];
+    if (scratch.storage.empty())
+      scratch.Reserve(expression);
+    EvaluateBlocks(expression, written, columns, begin, end, outputs, out, scratch);
+  });
+}
+
+void EvaluateBatch(const CompiledExpression& expression, const double* const* columns, size_t rowsNum, double* out) {
+  RunBatch(expression, columns, rowsNum, nullptr, out, nullptr);
+}
+
+void EvaluateBatch(const CompiledExpression& expression, const double* const* columns, size_t rowsNum, double* out, ThreadPool& pool) {
+  RunBatch(expression, columns, rowsNum, nullptr, out, &pool);
+}
+
+void EvaluateFusedBatch(const CompiledExpression& expression, const double* const* columns, size_t rowsNum, double* const* outputs) {
+  RunBatch(expression, columns, rowsNum, outputs, outputs[expression.GetOutputsCount() - 1], nullptr);
+}
+
+void EvaluateFusedBatch(const CompiledExpression& expression, const double* const* columns, size_t rowsNum, double* const* outputs, ThreadPool& pool) {
+  RunBatch(expression, columns, rowsNum, outputs, outputs[expression.GetOutputsCount() - 1], &pool);
+}
\ No newline at end of file
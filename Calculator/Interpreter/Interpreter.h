@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../Compiler/Compiler.h"
+#include "../ThreadPool/ThreadPool.h"
+
+/**
+* @brief data stack size of Evaluate which does not require heap allocation
+*/
+constexpr size_t EVALUATE_STACK_SIZE = 64;
+
+/**
+* @brief compiled expression evaluating function
+* @details built-in operations are executed in place, other ones are called directly through stored pointers,
+* the loop uses direct-threaded dispatch where the compiler supports computed goto
+* @param[in] expression - compiled expression
+* @param[in/out] binding - values of variables, assignments are written back to it
+* @return result of evaluating
+* @warning data stack is kept on the call stack for programs up to EVALUATE_STACK_SIZE deep, so evaluation does not allocate
+*/
+double Evaluate(const CompiledExpression& expression, VariableBinding& binding);
+
+/**
+* @brief compiled expression evaluating function which also gives results of all expressions of fused program
+* @param[in] expression - compiled expression
+* @param[in/out] binding - values of variables, assignments are written back to it
+* @param[out] outputs - array of expression.GetOutputsCount() results, may be nullptr
+* @return result of the last expression
+*/
+double Evaluate(const CompiledExpression& expression, VariableBinding& binding, double* outputs);
+
+/**
+* @brief number of rows evaluated by one pass over program in EvaluateBatch
+*/
+constexpr size_t BATCH_SIZE = 1024;
+
+/**
+* @brief compiled expression evaluating function for many rows of variable values
+* @details the program is executed one instruction at a time over blocks of BATCH_SIZE rows, so dispatch cost is shared by the block,
+* every row starts with values from columns, variables assigned by expression are copied to block-local columns,
+* operations with batch kernel are called once per block, see Operation::SetBatchOperation, programs with operations called through Operation::DoOperation or operators on variable references are evaluated row by row
+* @param[in] expression - compiled expression
+* @param[in] columns - values of variables, columns[slot] points to rowsNum values of variable with this slot or is nullptr if variable is not init
+* @param[in] rowsNum - number of rows
+* @param[out] out - array of rowsNum results
+* @throw std::exception if evaluating of any row fails
+*/
+void EvaluateBatch(const CompiledExpression& expression, const double* const* columns, size_t rowsNum, double* out);
+
+/**
+* @brief number of row ranges per worker thread which parallel EvaluateBatch splits rows into
+*/
+constexpr size_t PARALLEL_RANGES_PER_THREAD = 8;
+
+/**
+* @brief compiled expression evaluating function for many rows of variable values on thread pool
+* @details rows are split into ranges of whole blocks which are evaluated like in EvaluateBatch by worker threads,
+* every worker has its own data stack, shared data (expression and columns) is only read, so operations called by expression must be thread safe
+* @param[in] expression - compiled expression
+* @param[in] columns - values of variables, columns[slot] points to rowsNum values of variable with this slot or is nullptr if variable is not init
+* @param[in] rowsNum - number of rows
+* @param[out] out - array of rowsNum results
+* @param[in] pool - thread pool
+* @throw std::exception if evaluating of any row fails
+* @warning the function must not be called from a task of the same pool
+*/
+void EvaluateBatch(const CompiledExpression& expression, const double* const* columns, size_t rowsNum, double* out, ThreadPool& pool);
+
+/**
+* @brief fused program evaluating function for many rows of variable values
+* @details rows are evaluated like in EvaluateBatch, every input column is read once for all expressions of program
+* @param[in] expression - compiled program
+* @param[in] columns - values of variables, columns[slot] points to rowsNum values of variable with this slot or is nullptr if variable is not init
+* @param[in] rowsNum - number of rows
+* @param[out] outputs - expression.GetOutputsCount() arrays of rowsNum results
+* @throw std::exception if evaluating of any row fails
+*/
+void EvaluateFusedBatch(const CompiledExpression& expression, const double* const* columns, size_t rowsNum, double* const* outputs);
+
+/**
+* @brief fused program evaluating function for many rows of variable values on thread pool
+* @details rows are split between workers like in parallel EvaluateBatch
+* @param[in] expression - compiled program
+* @param[in] columns - values of variables, columns[slot] points to rowsNum values of variable with this slot or is nullptr if variable is not init
+* @param[in] rowsNum - number of rows
+* @param[out] outputs - expression.GetOutputsCount() arrays of rowsNum results
+* @param[in] pool - thread pool
+* @throw std::exception if evaluating of any row fails
+* @warning the function must not be called from a task of the same pool
+*/
+void EvaluateFusedBatch(const CompiledExpression& expression, const double* const* columns, size_t rowsNum, double* const* outputs, ThreadPool& pool);
\ No newline at end of file
@@ -0,0 +1,368 @@
+#include "JIT.h"
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define JIT_AVAILABLE
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+/**
+* @brief exception thrown by operation called from machine code
+* @details exceptions can not be unwound through generated code, so they are caught by call helpers and rethrown by Run
+*/
+thread_local std::exception_ptr nativeError;
+
+template <typename Call>
+double GuardedCall(Call call) noexcept {
+  if (nativeError)
+    return std::numeric_limits<double>::quiet_NaN();  //operations after the failed one are not called
+  try {
+    return call();
+  }
+  catch (...) {
+    nativeError = std::current_exception();
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+}
+
+double CallBinary(BinaryOperator::DoValueBinaryOperation doOperation, const double* args) noexcept {
+  return GuardedCall([&]() { return doOperation(Value(args[0]), Value(args[1])); });
+}
+
+double CallUnary(PreficsOperator::DoValuePreficsOperation doOperation, const double* args) noexcept {
+  return GuardedCall([&]() { return doOperation(Value(args[0])); });
+}
+
+double CallFunc1(Function::DoUnaryFunc doFunc, const double* args) noexcept {
+  return GuardedCall([&]() { return doFunc(args[0]); });
+}
+
+double CallFunc2(Function::DoBinaryFunc doFunc, const double* args) noexcept {
+  return GuardedCall([&]() { return doFunc(args[0], args[1]); });
+}
+
+double CallFuncN(Function::DoSpanFunc doFunc, const double* args, size_t argsNum) noexcept {
+  return GuardedCall([&]() { return doFunc(args, argsNum); });
+}
+
+#ifdef JIT_AVAILABLE
+/**
+* @brief enum of x86-64 registers
+*/
+enum Register {
+  RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RBP = 5, RSI = 6, RDI = 7,
+  R8 = 8, R9 = 9, R10 = 10, R11 = 11, R12 = 12, R13 = 13, R14 = 14, R15 = 15,
+  XMM0 = 0, XMM1 = 1
+};
+
+#ifdef _WIN32
+const Register ARG_REGISTERS[] = { RCX, RDX, R8 };
+const unsigned char SHADOW_SPACE = 32;
+#else
+const Register ARG_REGISTERS[] = { RDI, RSI, RDX };
+const unsigned char SHADOW_SPACE = 0;
+#endif
+
+/**
+* @brief class of x86-64 machine code writer, only instructions used by CompileNative are supported
+*/
+class Assembler {
+public:
+  /**
+  * @brief method of writing bytes
+  * @param[in] bytes - bytes
+  */
+  void Bytes(std::initializer_list<unsigned char> bytes) {
+    code.insert(code.end(), bytes);
+  }
+
+  /**
+  * @brief method of writing little-endian integer
+  * @param[in] value - integer
+  * @param[in] size - size of integer in bytes
+  */
+  void Immediate(uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; ++i)
+      code.push_back((unsigned char)(value >> (8 * i)));
+  }
+
+  /**
+  * @brief method of writing instruction with memory operand [base + disp32]
+  * @param[in] prefix - mandatory prefix, 0 if there is no prefix
+  * @param[in] wide - true if operand size is 64 bits
+  * @param[in] opcode - opcode bytes
+  * @param[in] reg - register operand
+  * @param[in] base - base register of memory operand
+  * @param[in] disp - displacement of memory operand
+  */
+  void Memory(unsigned char prefix, bool wide, std::initializer_list<unsigned char> opcode, Register reg, Register base, int32_t disp) {
+    if (prefix != 0)
+      code.push_back(prefix);
+    unsigned char rex = 0x40 | (wide ? 0x08 : 0) | (reg & 8 ? 0x04 : 0) | (base & 8 ? 0x01 : 0);
+    if (rex != 0x40)
+      code.push_back(rex);
+    Bytes(opcode);
+    code.push_back(0x80 | (reg & 7) << 3 | (base & 7));
+    if ((base & 7) == RSP)
+      code.push_back(0x24);
+    Immediate(uint32_t(disp), 4);
+  }
+
+  /**
+  * @brief method of writing mov reg, imm64
+  * @param[in] reg - destination register
+  * @param[in] value - immediate value
+  */
+  void MovImmediate(Register reg, uint64_t value) {
+    Bytes({ (unsigned char)(0x48 | (reg & 8 ? 0x01 : 0)), (unsigned char)(0xB8 | (reg & 7)) });
+    Immediate(value, 8);
+  }
+
+  /**
+  * @brief method of writing mov dst, src for 64-bit registers
+  * @param[in] dst - destination register
+  * @param[in] src - source register
+  */
+  void MovRegister(Register dst, Register src) {
+    Bytes({ (unsigned char)(0x48 | (src & 8 ? 0x04 : 0) | (dst & 8 ? 0x01 : 0)), 0x89, (unsigned char)(0xC0 | (src & 7) << 3 | (dst & 7)) });
+  }
+
+  /**
+  * @brief method of writing call of function by absolute address
+  * @param[in] target - function address
+  */
+  void Call(uint64_t target) {
+    MovImmediate(RAX, target);
+    Bytes({ 0xFF, 0xD0 });
+  }
+
+  /**
+  * @brief written code
+  */
+  std::vector<unsigned char> code;
+};
+
+/**
+* @brief function of getting address of function as immediate value
+* @param[in] function - function pointer
+* @return address
+*/
+template <typename Func>
+uint64_t Address(Func function) {
+  return uint64_t(reinterpret_cast<uintptr_t>(function));
+}
+
+/**
+* @brief function of getting offset of stack's element
+* @param[in] index - index in array of doubles
+* @return offset in bytes
+*/
+int32_t Slot(size_t index) {
+  return int32_t(index * sizeof(double));
+}
+
+std::unique_ptr<NativeExpression> CompileNative(const CompiledExpression& expression) {
+  using OpCode = CompiledExpression::OpCode;
+  const unsigned char SSE_PREFIX = 0xF2;
+  const unsigned char MOVSD_LOAD = 0x10, MOVSD_STORE = 0x11;
+
+  Assembler assembler;
+  //rbx - stack, r12 - temporaries, r13 - variables
+  assembler.Bytes({ 0x53, 0x41, 0x54, 0x41, 0x55 });
+  if (SHADOW_SPACE != 0)
+    assembler.Bytes({ 0x48, 0x83, 0xEC, SHADOW_SPACE });
+  assembler.MovRegister(RBX, ARG_REGISTERS[0]);
+  assembler.MovRegister(R12, ARG_REGISTERS[1]);
+  assembler.MovRegister(R13, ARG_REGISTERS[2]);
+
+  auto load = [&](Register base, size_t index) { assembler.Memory(0, true, { 0x8B }, RAX, base, Slot(index)); };
+  auto store = [&](Register base, size_t index) { assembler.Memory(0, true, { 0x89 }, RAX, base, Slot(index)); };
+  auto sse = [&](unsigned char opcode, size_t index) { assembler.Memory(SSE_PREFIX, false, { 0x0F, opcode }, XMM0, RBX, Slot(index)); };
+  auto call = [&](uint64_t helper, uint64_t callback, size_t first, size_t argsNum, bool passArgsNum) {
+    assembler.MovImmediate(ARG_REGISTERS[0], callback);
+    assembler.Memory(0, true, { 0x8D }, ARG_REGISTERS[1], RBX, Slot(first));
+    if (passArgsNum)
+      assembler.MovImmediate(ARG_REGISTERS[2], argsNum);
+    assembler.Call(helper);
+    sse(MOVSD_STORE, first);
+  };
+
+  size_t depth = 0;
+  for (auto& instruction : expression.GetProgram()) {
+    switch (instruction.code) {
+    case OpCode::PUSH_LITERAL: {
+      double value = expression.GetLiteral(instruction.arg);
+      uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      assembler.MovImmediate(RAX, bits);
+      store(RBX, depth++);
+      break;
+    }
+    case OpCode::LOAD_VARIABLE:
+      load(R13, instruction.arg);
+      store(RBX, depth++);
+      break;
+    case OpCode::LOAD_TEMP:
+      load(R12, instruction.arg);
+      store(RBX, depth++);
+      break;
+    case OpCode::SAVE_TEMP:
+      load(RBX, depth - 1);
+      store(R12, instruction.arg);
+      break;
+    case OpCode::ADD:
+    case OpCode::SUB:
+    case OpCode::MUL:
+    case OpCode::DIV:
+    case OpCode::MAX: {
+      //addsd, subsd, mulsd, divsd, maxsd
+      const unsigned char opcodes[] = { 0x58, 0x5C, 0x59, 0x5E };
+      unsigned char opcode = instruction.code == OpCode::MAX ? 0x5F : opcodes[size_t(instruction.code) - size_t(OpCode::ADD)];
+      sse(MOVSD_LOAD, depth - 2);
+      sse(opcode, depth - 1);
+      sse(MOVSD_STORE, depth - 2);
+      --depth;
+      break;
+    }
+    case OpCode::NEG:
+      load(RBX, depth - 1);
+      assembler.Bytes({ 0x48, 0x0F, 0xBA, 0xF8, 0x3F });  //btc rax, 63
+      store(RBX, depth - 1);
+      break;
+    case OpCode::CALL_BINARY:
+      call(Address(CallBinary), Address(instruction.callback.binary), depth - 2, 2, false);
+      --depth;
+      break;
+    case OpCode::CALL_UNARY:
+      call(Address(CallUnary), Address(instruction.callback.unary), depth - 1, 1, false);
+      break;
+    case OpCode::CALL_FUNC1:
+      call(Address(CallFunc1), Address(instruction.callback.func1), depth - 1, 1, false);
+      break;
+    case OpCode::CALL_FUNC2:
+      call(Address(CallFunc2), Address(instruction.callback.func2), depth - 2, 2, false);
+      --depth;
+      break;
+    case OpCode::CALL_FUNCN:
+      call(Address(CallFuncN), Address(instruction.callback.funcN), depth - instruction.arg, instruction.arg, true);
+      depth = depth - instruction.arg + 1;
+      break;
+    case OpCode::RETURN:
+      sse(MOVSD_LOAD, 0);
+      if (SHADOW_SPACE != 0)
+        assembler.Bytes({ 0x48, 0x83, 0xC4, SHADOW_SPACE });
+      assembler.Bytes({ 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3 });
+      break;
+    default:
+      return nullptr;
+    }
+  }
+
+  try {
+    return std::make_unique<NativeExpression>(assembler.code, expression);
+  }
+  catch (const std::exception&) {
+    return nullptr;
+  }
+}
+#else
+std::unique_ptr<NativeExpression> CompileNative(const CompiledExpression& expression) {
+  return nullptr;
+}
+#endif
+
+NativeExpression::NativeExpression(const std::vector<unsigned char>& code, const CompiledExpression& expression) :
+  size(code.size()), variablesCount(expression.GetVariablesCount()),
+  tempsCount(expression.GetTempsCount()), maxDepth(expression.GetMaxDepth()) {
+#ifdef _WIN32
+  this->code = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+  if (this->code == nullptr)
+    throw std::runtime_error("Impossible to allocate executable memory");
+  std::memcpy(this->code, code.data(), size);
+  DWORD oldProtect;
+  if (!VirtualProtect(this->code, size, PAGE_EXECUTE_READ, &oldProtect)) {
+    VirtualFree(this->code, 0, MEM_RELEASE);
+    throw std::runtime_error("Impossible to allocate executable memory");
+  }
+  FlushInstructionCache(GetCurrentProcess(), this->code, size);
+#else
+  this->code = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (this->code == MAP_FAILED)
+    throw std::runtime_error("Impossible to allocate executable memory");
+  std::memcpy(this->code, code.data(), size);
+  if (mprotect(this->code, size, PROT_READ | PROT_EXEC) != 0) {
+    munmap(this->code, size);
+    throw std::runtime_error("Impossible to allocate executable memory");
+  }
+#endif
+}
+
+NativeExpression::~NativeExpression() {
+#ifdef _WIN32
+  VirtualFree(code, 0, MEM_RELEASE);
+#else
+  munmap(code, size);
+#endif
+}
+
+double NativeExpression::Run(const VariableBinding& binding) const {
+  double localStorage[EVALUATE_STACK_SIZE];
+  std::vector<double> heapStorage;
+  double* variables = localStorage;
+  size_t required = variablesCount + tempsCount + maxDepth;
+  if (required > EVALUATE_STACK_SIZE) {
+    heapStorage.resize(required);
+    variables = heapStorage.data();
+  }
+  double* temps = variables + variablesCount;
+  double* stack = temps + tempsCount;
+
+  //all variables of supported programs are only read
+  for (size_t slot = 0; slot < variablesCount; ++slot)
+    variables[slot] = binding.GetVariable(slot).GetValue();
+
+  nativeError = nullptr;
+  double result = reinterpret_cast<NativeFunc>(code)(stack, temps, variables);
+  if (nativeError) {
+    std::exception_ptr error = nativeError;
+    nativeError = nullptr;
+    std::rethrow_exception(error);
+  }
+  return result;
+}
+
+TieredExpression::TieredExpression(CompiledExpression expression) : expression(std::move(expression)) {}
+
+double TieredExpression::Evaluate(VariableBinding& binding) {
+  const NativeExpression* code = native.load(std::memory_order_acquire);
+  if (code != nullptr)
+    return code->Run(binding);
+  if (evaluations.load(std::memory_order_relaxed) < JIT_THRESHOLD &&
+      evaluations.fetch_add(1, std::memory_order_relaxed) + 1 == JIT_THRESHOLD)
+    Promote();
+  return ::Evaluate(expression, binding);
+}
+
+bool TieredExpression::Promote(void) {
+  std::call_once(compileFlag, [this]() {
+    nativeOwner = CompileNative(expression);
+    native.store(nativeOwner.get(), std::memory_order_release);
+  });
+  return IsNative();
+}
+
+bool TieredExpression::IsNative(void) const {
+  return native.load(std::memory_order_acquire) != nullptr;
+}
+
+const CompiledExpression& TieredExpression::GetExpression(void) const {
+  return expression;
+}
\ No newline at end of file
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "../Interpreter/Interpreter.h"
+#include <atomic>
+#include <mutex>
+
+/**
+* @brief number of evaluations after which TieredExpression compiles expression into machine code
+*/
+constexpr size_t JIT_THRESHOLD = 1000;
+
+/**
+* @brief class of compiled expression translated into x86-64 machine code
+* @details the code keeps data stack in memory at offsets known at compile time, so there is no dispatch
+* and no stack pointer, built-in arithmetic is executed with SSE2 instructions, other operations are called through pointers
+*/
+class NativeExpression {
+public:
+  /**
+  * @brief signature of generated code
+  */
+  using NativeFunc = double(*)(double* stack, double* temps, const double* variables);
+
+  /**
+  * @brief default consructor (deleted)
+  * @warning the method is deleted
+  */
+  NativeExpression() = delete;
+
+  /**
+  * @brief constructor, copies code into executable memory
+  * @param[in] code - machine code
+  * @param[in] expression - compiled expression which code is generated from
+  * @throw std::exception if executable memory can not be allocated
+  */
+  NativeExpression(const std::vector<unsigned char>& code, const CompiledExpression& expression);
+
+  /**
+  * @brief copy consructor (deleted)
+  * @warning the method is deleted
+  */
+  NativeExpression(const NativeExpression&) = delete;
+
+  /**
+  * @brief move consructor (deleted)
+  * @warning the method is deleted
+  */
+  NativeExpression(NativeExpression&&) = delete;
+
+  /**
+  * @brief copy operator (deleted)
+  * @warning the operator is deleted
+  */
+  NativeExpression operator=(const NativeExpression&) = delete;
+
+  /**
+  * @brief move operator (deleted)
+  * @warning the operator is deleted
+  */
+  NativeExpression operator=(NativeExpression&&) = delete;
+
+  /**
+  * @brief destructor, releases executable memory
+  */
+  ~NativeExpression();
+
+  /**
+  * @brief method of running machine code
+  * @param[in] binding - values of variables
+  * @return result of evaluating
+  * @throw std::exception if variable is not init or called operation throws
+  */
+  double Run(const VariableBinding& binding) const;
+private:
+  /**
+  * @brief executable memory
+  */
+  void* code;
+
+  /**
+  * @brief size of executable memory
+  */
+  size_t size;
+
+  /**
+  * @brief number of variable's slots
+  */
+  size_t variablesCount;
+
+  /**
+  * @brief number of temporaries
+  */
+  size_t tempsCount;
+
+  /**
+  * @brief maximum stack depth
+  */
+  size_t maxDepth;
+};
+
+
+
+
+/**
+* @brief class of compiled expression which is evaluated by interpreter until it becomes hot
+* @details after JIT_THRESHOLD evaluations the expression is compiled into machine code once,
+* if it is not possible, the expression stays on interpreter.
+* The expression may be evaluated by several threads at the same time, machine code is published once through atomic pointer
+*/
+class TieredExpression {
+public:
+  /**
+  * @brief default consructor (deleted)
+  * @warning the method is deleted
+  */
+  TieredExpression() = delete;
+
+  /**
+  * @brief constructor
+  * @param[in] expression - compiled expression
+  */
+  TieredExpression(CompiledExpression expression);
+
+  /**
+  * @brief copy consructor (deleted)
+  * @warning the method is deleted
+  */
+  TieredExpression(const TieredExpression&) = delete;
+
+  /**
+  * @brief copy operator (deleted)
+  * @warning the operator is deleted
+  */
+  TieredExpression& operator= (const TieredExpression&) = delete;
+
+  /**
+  * @brief default destructor
+  */
+  ~TieredExpression() = default;
+
+  /**
+  * @brief method of evaluating expression
+  * @param[in/out] binding - values of variables, assignments are written back to it
+  * @return result of evaluating
+  */
+  double Evaluate(VariableBinding& binding);
+
+  /**
+  * @brief method of compiling expression into machine code without waiting for JIT_THRESHOLD evaluations
+  * @return true if expression is evaluated by machine code, false otherwise
+  */
+  bool Promote(void);
+
+  /**
+  * @brief method of check that expression is compiled into machine code
+  * @return true if expression is evaluated by machine code, false otherwise
+  */
+  bool IsNative(void) const;
+
+  /**
+  * @brief getter of compiled expression
+  * @return compiled expression
+  */
+  const CompiledExpression& GetExpression(void) const;
+private:
+  /**
+  * @brief compiled expression
+  */
+  CompiledExpression expression;
+
+  /**
+  * @brief number of evaluations by interpreter, it is not increased after JIT_THRESHOLD
+  */
+  std::atomic<size_t> evaluations = 0;
+
+  /**
+  * @brief machine code of expression, nullptr if it is not compiled
+  */
+  std::atomic<const NativeExpression*> native = nullptr;
+
+  /**
+  * @brief owner of machine code
+  */
+  std::unique_ptr<NativeExpression> nativeOwner;
+
+  /**
+  * @brief guard of compiling expression into machine code
+  */
+  std::once_flag compileFlag;
+};
+
+/**
+* @brief function of compiling expression into machine code
+* @details variables are read by value before the code is run, so programs with assignments, increments
+* and operations called through Operation::DoOperation are not supported
+* @param[in] expression - compiled expression
+* @return machine code of expression, nullptr if expression or platform is not supported
+*/
+std::unique_ptr<NativeExpression> CompileNative(const CompiledExpression& expression);
\ No newline at end of file
@@ -1,14 +1,68 @@
 ﻿#include "Calc/Calculator.h"
 #include "BaseOperations/BaseOperation.h"
 #include "ModuleManager/ModuleManager.h"
+#include "Columnar/Columnar.h"
+#include "Csv/Csv.h"
+#include <cstdlib>
 #include <iostream>
 
+#ifdef _MSC_VER
 #define _CRTDBG_MAP_ALLOC
 #include <crtdbg.h>
+#endif
 
-int main(){
+/**
+* @brief function of evaluating expressions over file of rows
+* @details arguments are (--csv input.csv | --col input.col) --expr "expression" [--expr "expression" ...] --out output [--threads number],
+* all expressions are evaluated in one pass, output has the same format as input and column for every expression
+* @param[in] argc - number of arguments
+* @param[in] argv - arguments
+* @return exit code
+*/
+int RunFile(int argc, char* argv[]) {
+  std::string csvInput, columnarInput, output;
+  std::vector<std::string> expressions;
+  size_t threadsNum = 0;
+  for (int i = 1; i < argc; i += 2) {
+    std::string key = argv[i];
+    if (i + 1 == argc || (key != "--csv" && key != "--col" && key != "--expr" && key != "--out" && key != "--threads")) {
+      std::cout << "Usage: Calculator (--csv input.csv | --col input.col) --expr \"expression\" [--expr ...] --out output [--threads number]" << std::endl;
+      return 1;
+    }
+    if (key == "--csv")
+      csvInput = argv[i + 1];
+    else if (key == "--col")
+      columnarInput = argv[i + 1];
+    else if (key == "--expr")
+      expressions.push_back(argv[i + 1]);
+    else if (key == "--out")
+      output = argv[i + 1];
+    else
+      threadsNum = std::strtoul(argv[i + 1], nullptr, 10);
+  }
+  if (csvInput.empty() == columnarInput.empty() || expressions.empty() || output.empty()) {
+    std::cout << "One of options --csv and --col and options --expr and --out are required" << std::endl;
+    return 1;
+  }
+
+  try {
+    ThreadPool pool(threadsNum);
+    size_t rowsNum = csvInput.empty() ? EvaluateColumnar(columnarInput, expressions, output, &pool)
+                                      : EvaluateCsv(csvInput, expressions, output, &pool);
+    std::cout << rowsNum << " rows evaluated" << std::endl;
+  }
+  catch (const std::exception& except) {
+    std::cout << except.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char* argv[]){
+#ifdef _MSC_VER
   _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
   _CrtSetReportMode(_CRT_WARN, _CRTDBG_MODE_DEBUG);
+#endif
 
   OperationsDescription& dstr = OperationsDescription::GetInstance();
   try {
@@ -19,6 +73,12 @@ int main(){
     std::cout << except.what() << std::endl;
   }
 
+  if (argc > 1) {
+    int code = RunFile(argc, argv);
+    dstr.Clear();
+    return code;
+  }
+
   std::string str;
   while (std::getline(std::cin, str) && str != "exit") {
     try{
@@ -1,27 +1,313 @@
 #include "ModuleManager.h"
+#include "../ThreadPool/ThreadPool.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
 
-std::vector<HINSTANCE> ModuleManager::linkedLibraries = {};
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+std::vector<void*> ModuleManager::linkedLibraries = {};
 
 ModuleManager& ModuleManager::GetInstance() {
   static ModuleManager moduleManager;
   return moduleManager;
 }
 
+void ModuleManager::Open(Module& module) const {
+#ifdef _WIN32
+  HMODULE hdll = LoadLibrary(module.file.string().c_str());
+  if (!hdll) {
+    module.error = "Unable to open " + module.file.filename().string() + ": error " + std::to_string(GetLastError());
+    return;
+  }
+  module.handle = hdll;
+  auto func = (Func)(GetProcAddress(hdll, LPCSTR(funcName.c_str())));
+#else
+  module.handle = dlopen(module.file.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (!module.handle) {
+    const char* reason = dlerror();
+    module.error = "Unable to open " + module.file.filename().string() + ": " + (reason != nullptr ? reason : "unknown error");
+    return;
+  }
+  auto func = (Func)(dlsym(module.handle, funcName.c_str()));
+#endif
+  if (!func) {
+    module.error = "Unable to load operations from " + module.file.filename().string();
+    return;
+  }
+  try {
+    module.staging = OperationsDescription::CreateStaging();
+    func(*module.staging);
+  }
+  catch (const std::exception& except) {
+    module.staging.reset();
+    module.error = module.file.filename().string() + ": " + except.what();
+  }
+}
+
+/**
+* @brief operation of stub of function, stubs are replaced by loaded operations before they are called
+* @throw std::exception always
+*/
+static double NotLoadedFunction(const double*, size_t) {
+  throw std::runtime_error("Module of operation is not loaded");
+}
+
+/**
+* @brief operation of stub of prefics or postfics operator
+* @throw std::exception always
+*/
+static double NotLoadedUnary(const Value&) {
+  throw std::runtime_error("Module of operation is not loaded");
+}
+
+/**
+* @brief operation of stub of binary operator
+* @throw std::exception always
+*/
+static double NotLoadedBinary(const Value&, const Value&) {
+  throw std::runtime_error("Module of operation is not loaded");
+}
+
+/**
+* @brief function of reading stub of operation from line of manifest
+* @param[in] line - line of manifest
+* @param[out] stubs - stubs, stub is added to them
+* @return false if line is not valid, true otherwise, empty lines and lines starting with # are skipped
+*/
+static bool ReadStub(const std::string& line, std::vector<std::shared_ptr<Operation>>& stubs) {
+  std::istringstream fields(line);
+  std::string kind, name, argument, rest;
+  if (!(fields >> kind) || kind[0] == '#')
+    return true;
+  bool valid = static_cast<bool>(fields >> name);
+  if (kind == "function") {
+    int argsNum = -1;
+    valid = valid && fields >> argsNum && argsNum >= 0;
+    if (valid)
+      stubs.push_back(std::make_shared<Function>(name, argsNum, NotLoadedFunction, false));
+  }
+  else if (kind == "prefics") {
+    int priority = 0;
+    valid = valid && fields >> priority;
+    if (valid)
+      stubs.push_back(std::make_shared<PreficsOperator>(name, priority, NotLoadedUnary, false));
+  }
+  else if (kind == "postfics") {
+    if (valid)
+      stubs.push_back(std::make_shared<PostficsOperator>(name, NotLoadedUnary, false));
+  }
+  else if (kind == "binary") {
+    int priority = 0;
+    valid = valid && fields >> priority >> argument && (argument == "left" || argument == "right");
+    if (valid)
+      stubs.push_back(std::make_shared<BinaryOperator>(name, priority, NotLoadedBinary,
+        argument == "left" ? BinaryOperator::Associative::LEFT : BinaryOperator::Associative::RIGHT, false));
+  }
+  else if (kind == "open") {
+    if (valid)
+      stubs.push_back(std::make_shared<OpenBracket>(name, nullptr));
+  }
+  else if (kind == "close") {
+    valid = valid && fields >> argument;
+    if (valid)
+      stubs.push_back(std::make_shared<CloseBracket>(name, argument));
+  }
+  else
+    valid = false;
+  return valid && !(fields >> rest && rest[0] != '#');
+}
+
+/**
+* @brief function of writing operation as line of manifest
+* @param[in] operation - operation
+* @return line of manifest, empty if operation can not be described by manifest
+*/
+static std::string WriteStub(const Operation& operation) {
+  switch (operation.GetType()) {
+  case ElementType::FUNCTION: {
+    int argsNum = dynamic_cast<const Function&>(operation).GetArgsNum();
+    return argsNum < 0 ? std::string() : "function " + operation.GetTokenName() + " " + std::to_string(argsNum);
+  }
+  case ElementType::PREFICS:
+    return "prefics " + operation.GetTokenName() + " " + std::to_string(dynamic_cast<const PreficsOperator&>(operation).GetPriority());
+  case ElementType::POSTFICS:
+    return "postfics " + operation.GetTokenName();
+  case ElementType::BINARY: {
+    auto& binary = dynamic_cast<const BinaryOperator&>(operation);
+    return "binary " + operation.GetTokenName() + " " + std::to_string(binary.GetPriority()) +
+           (binary.GetAssociative() == BinaryOperator::Associative::LEFT ? " left" : " right");
+  }
+  case ElementType::OPEN_BRACKET:
+    return "open " + operation.GetTokenName();
+  case ElementType::CLOSE_BRACKET:
+    return "close " + operation.GetTokenName() + " " + dynamic_cast<const CloseBracket&>(operation).GetPare();
+  default:
+    return std::string();
+  }
+}
+
+bool ModuleManager::ReadManifest(Module& module) const {
+  std::filesystem::path manifest = module.file;
+  manifest.replace_extension(MANIFEST_EXTENSION);
+  std::ifstream input(manifest);
+  if (!input)
+    return false;
+
+  std::string line;
+  for (size_t lineNum = 1; std::getline(input, line); ++lineNum)
+    if (!ReadStub(line, module.stubs)) {
+      module.stubs.clear();
+      module.error = manifest.filename().string() + ": error in line " + std::to_string(lineNum);
+      return false;
+    }
+  return true;
+}
+
+void ModuleManager::ReadCache(std::vector<Module>& modules) const {
+  std::ifstream input(std::filesystem::current_path() / path / MODULES_CACHE, std::ios::binary);
+  if (!input)
+    return;
+  std::stringstream cache;
+  cache << input.rdbuf();
+  std::string line;
+  if (!std::getline(cache, line) || line != MODULES_CACHE_VERSION)
+    return;
+
+  std::string word, name;
+  Module key;
+  size_t stubsNum = 0;
+  while (std::getline(cache, line)) {
+    std::istringstream fields(line);
+    if (!(fields >> word >> std::quoted(name) >> key.size >> key.time >> key.manifestTime >> stubsNum) || word != "module")
+      return;
+    auto module = std::lower_bound(modules.begin(), modules.end(), name,
+      [](const Module& module, const std::string& name) { return module.file.filename().string() < name; });
+    bool valid = module != modules.end() && module->file.filename().string() == name &&
+                 module->size == key.size && module->time == key.time && module->manifestTime == key.manifestTime;
+    std::vector<std::shared_ptr<Operation>> stubs;
+    for (size_t i = 0; i < stubsNum; ++i)
+      if (!std::getline(cache, line) || !ReadStub(line, stubs))
+        return;
+    if (valid && stubs.size() == stubsNum) {
+      module->stubs = std::move(stubs);
+      module->cached = true;
+    }
+  }
+}
+
+void ModuleManager::WriteCache(const std::vector<Module>& modules) const {
+  std::ostringstream cache;
+  cache << MODULES_CACHE_VERSION << '\n';
+  for (auto& module : modules) {
+    if (!module.cached && !module.staging && module.stubs.empty())
+      continue;
+    std::vector<std::shared_ptr<Operation>> operations = module.staging ? module.staging->GetOperations() : module.stubs;
+    std::vector<std::string> lines;
+    for (auto& operation : operations)
+      lines.push_back(WriteStub(*operation));
+    if (std::find(lines.begin(), lines.end(), std::string()) != lines.end())
+      continue;
+    cache << "module " << std::quoted(module.file.filename().string()) << ' ' << module.size << ' '
+          << module.time << ' ' << module.manifestTime << ' ' << lines.size() << '\n';
+    for (auto& line : lines)
+      cache << line << '\n';
+  }
+
+  std::filesystem::path file = std::filesystem::current_path() / path / MODULES_CACHE;
+  std::filesystem::path temp = file;
+  temp += "." + std::to_string(std::random_device()());
+  {
+    std::ofstream output(temp, std::ios::binary);
+    if (!(output << cache.str()))
+      return;
+  }
+  std::error_code code;
+  std::filesystem::rename(temp, file, code);
+  if (code)
+    std::filesystem::remove(temp, code);
+}
+
+std::unique_ptr<OperationsDescription> ModuleManager::OpenDeferred(const std::filesystem::path& file) {
+  Module module = { file, nullptr, nullptr, {}, 0, 0, 0, false, {} };
+  Open(module);
+  if (module.handle) {
+    std::lock_guard<std::mutex> lock(librariesMutex);
+    linkedLibraries.push_back(module.handle);
+  }
+  if (!module.error.empty())
+    throw std::runtime_error(module.error.c_str());
+  return std::move(module.staging);
+}
+
 void ModuleManager::LoadDll(OperationsDescription& dstr) {
-  HMODULE hdll = nullptr;
-
-  for (auto& dll : std::filesystem::directory_iterator(std::filesystem::current_path().string() + "\\" + path)) {
-    if (dll.path().extension() == ".dll") {
-      hdll = LoadLibrary(dll.path().string().c_str());
-      if (hdll) {
-        linkedLibraries.push_back(hdll);
-
-        auto func = (Func)(GetProcAddress(hdll, LPCSTR(funcName.c_str())));
-        if (func)
-          func(dstr);
-        else
-          throw std::exception(("Unable to load operations from " + dll.path().filename().string()).c_str());
-      }
+  std::vector<Module> modules;
+  std::error_code code;
+  for (auto& dll : std::filesystem::directory_iterator(std::filesystem::current_path() / path)) {
+    if (dll.path().extension() != MODULE_EXTENSION)
+      continue;
+    Module module = { dll.path(), nullptr, nullptr, {}, 0, 0, 0, false, {} };
+    module.size = std::filesystem::file_size(module.file, code);
+    module.time = std::filesystem::last_write_time(module.file, code).time_since_epoch().count();
+    std::filesystem::path manifest = module.file;
+    manifest.replace_extension(MANIFEST_EXTENSION);
+    auto manifestTime = std::filesystem::last_write_time(manifest, code);
+    module.manifestTime = code ? 0 : manifestTime.time_since_epoch().count();
+    modules.push_back(std::move(module));
+  }
+  if (modules.empty())
+    return;
+  std::sort(modules.begin(), modules.end(), [](const Module& a, const Module& b) { return a.file < b.file; });
+
+  ReadCache(modules);
+  size_t uncachedNum = std::count_if(modules.begin(), modules.end(), [](const Module& module) { return !module.cached; });
+  if (uncachedNum != 0) {
+    ThreadPool pool(std::min<size_t>(uncachedNum, std::max(1u, std::thread::hardware_concurrency())));
+    pool.ParallelFor(modules.size(), 1, [&](size_t, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i)
+        if (!modules[i].cached && !ReadManifest(modules[i]))
+          Open(modules[i]);
+    });
+  }
+
+  std::vector<const OperationsDescription*> stagings;
+  std::string error;
+  for (auto& module : modules) {
+    if (module.handle) {
+      std::lock_guard<std::mutex> lock(librariesMutex);
+      linkedLibraries.push_back(module.handle);
+    }
+    if (module.staging)
+      stagings.push_back(module.staging.get());
+    if (error.empty())
+      error = module.error;
+  }
+  try {
+    dstr.Merge(stagings);
+  }
+  catch (const std::exception& except) {
+    if (error.empty())
+      error = except.what();
+  }
+  for (auto& module : modules) {
+    if (module.stubs.empty())
+      continue;
+    try {
+      dstr.Defer(module.stubs, [this, file = module.file]() { return OpenDeferred(file); });
+    }
+    catch (const std::exception& except) {
+      if (error.empty())
+        error = module.file.filename().string() + ": " + except.what();
     }
   }
+  if (!error.empty())
+    throw std::runtime_error(error.c_str());
+  if (uncachedNum != 0)
+    WriteCache(modules);
 };
\ No newline at end of file
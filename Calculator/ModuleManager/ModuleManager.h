@@ -1,13 +1,39 @@
 #pragma once
 
 #include <filesystem>
-#include <windows.h>
 #include <iostream>
 
-#include "..\API\API.h"
+#include "../API/API.h"
+
+/**
+* @brief extension of module's files
+*/
+#if defined(_WIN32)
+constexpr char MODULE_EXTENSION[] = ".dll";
+#elif defined(__APPLE__)
+constexpr char MODULE_EXTENSION[] = ".dylib";
+#else
+constexpr char MODULE_EXTENSION[] = ".so";
+#endif
+
+/**
+* @brief extension of module's manifest, manifest has the same name as module's file
+*/
+constexpr char MANIFEST_EXTENSION[] = ".manifest";
+
+/**
+* @brief name of file of cached manifests of modules, it is kept in modules directory
+*/
+constexpr char MODULES_CACHE[] = "modules.cache";
+
+/**
+* @brief the first line of cache file, cache with other first line is not read
+*/
+constexpr char MODULES_CACHE_VERSION[] = "Calc modules cache 1";
 
 /**
 * @brief singletone class for managing loaded dll
+* @details libraries are opened by LoadLibrary on Windows and by dlopen on other systems
 */
 class ModuleManager {
 public:
@@ -53,7 +79,18 @@ public:
 
   /**
   * @brief function for loadeing all dll from "path"
+  * @details libraries are opened and their Load functions are called in parallel, every library loads operations
+  * into its own staging storage, then storages are merged into dstr in order of file names and one snapshot is published,
+  * libraries which can not be opened are skipped.
+  * Library with manifest is not opened, stubs of operations listed in manifest are deferred instead,
+  * the library is opened when any of its names is used in compiled expression for the first time.
+  * Every line of manifest describes one operation, empty lines and lines starting with # are skipped:
+  * function name argsNum | prefics name priority | postfics name | binary name priority left|right | open name | close name pare.
+  * Manifests of all libraries, including ones written from operations of libraries without manifest, are cached in MODULES_CACHE,
+  * library whose file and manifest have the same size and times of change as in cache is deferred without reading its manifest
+  * or opening it, cache is rewritten if any library is not found in it and all libraries are loaded without errors
   * @param[in/out] dstr - storage of operations for loading in it operations from dll
+  * @throw std::exception if library has no Load function or its operations can not be loaded, operations of other libraries are loaded
   */
   void LoadDll(OperationsDescription& dstr);
 private:
@@ -63,9 +100,59 @@ private:
   ModuleManager() = default;
 
   /**
-  * @brief dll search path
+  * @brief struct of result of loading one library
+  */
+  struct Module {
+    std::filesystem::path file;                         ///< library's file
+    void* handle = nullptr;                             ///< handle of library, nullptr if it is not opened
+    std::unique_ptr<OperationsDescription> staging;     ///< operations of library
+    std::vector<std::shared_ptr<Operation>> stubs;      ///< stubs of operations listed in manifest, empty if library is opened
+    uintmax_t size = 0;                                 ///< size of library's file
+    long long time = 0;                                 ///< time of the last change of library's file
+    long long manifestTime = 0;                         ///< time of the last change of manifest, 0 if there is no manifest
+    bool cached = false;                                ///< true if stubs are read from cache
+    std::string error;                                  ///< error of loading, empty if there is no error
+  };
+
+  /**
+  * @brief method of opening library and calling its Load function
+  * @details if library can not be opened, error of module is set to name of file and reason given by system
+  * @param[in/out] module - library, its file is set
   */
-  const std::string path{ "..\\modules" };
+  void Open(Module& module) const;
+
+  /**
+  * @brief method of reading stubs of operations from manifest of library
+  * @param[in/out] module - library, its file is set
+  * @return true if library has manifest, false otherwise
+  */
+  bool ReadManifest(Module& module) const;
+
+  /**
+  * @brief method of reading stubs of operations from cache
+  * @param[in/out] modules - libraries sorted by file, stubs are read for libraries which are not changed since cache is written
+  */
+  void ReadCache(std::vector<Module>& modules) const;
+
+  /**
+  * @brief method of writing cache of manifests of libraries
+  * @details cache is written into temporary file which replaces the old one, so concurrent programs read either of them
+  * @param[in] modules - loaded libraries, libraries which are not opened are not written
+  */
+  void WriteCache(const std::vector<Module>& modules) const;
+
+  /**
+  * @brief method of opening library which operations are deferred
+  * @param[in] file - library's file
+  * @return staging storage with operations of library
+  * @throw std::exception if library can not be opened or has no Load function
+  */
+  std::unique_ptr<OperationsDescription> OpenDeferred(const std::filesystem::path& file);
+
+  /**
+  * @brief dll search path, relative to current directory
+  */
+  const std::filesystem::path path = std::filesystem::path("..") / "modules";
 
   /**
   * @brief imported function's name
@@ -75,5 +162,10 @@ private:
   /**
   * @brief plug-in descriptor store
   */
-  static std::vector<HINSTANCE> linkedLibraries;
+  static std::vector<void*> linkedLibraries;
+
+  /**
+  * @brief guard of linkedLibraries against libraries opened by concurrent compilations
+  */
+  std::mutex librariesMutex;
 };
\ No newline at end of file
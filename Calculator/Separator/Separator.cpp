@@ -1,4 +1,5 @@
 #include "Separator.h"
+#include <charconv>
 
 /**
 * @brief function to separate the space character from the current position
@@ -6,8 +7,8 @@
 * @param[in] curPos - current position in expression to start separating
 * @param[out] endOfTokenPos - token end position
 */
-void SeparateSpace(const std::string& expression, const size_t curPos, size_t& endOfTokenPos) {
-  for (curPos; isspace(expression[endOfTokenPos]); ++endOfTokenPos);
+void SeparateSpace(std::string_view expression, const size_t curPos, size_t& endOfTokenPos) {
+  for (curPos; endOfTokenPos < expression.size() && isspace(expression[endOfTokenPos]); ++endOfTokenPos);
 }
 
 /**
@@ -16,9 +17,9 @@ void SeparateSpace(const std::string& expression, const size_t curPos, size_t& e
 * @param[in] curPos - current position in expression to start separating
 * @param[out] endOfTokenPos - token end position
 */
-Token SeparateDelimetrArgs(const std::string& expression, const size_t curPos, size_t& endOfTokenPos) {
+Token SeparateDelimetrArgs(std::string_view expression, const size_t curPos, size_t& endOfTokenPos) {
   endOfTokenPos++;
-  return Token(Token::Type::DELIMETR_ARGS, { DELIMETR_ARGS });
+  return Token(Token::Type::DELIMETR_ARGS, expression.substr(curPos, 1));
 }
 
 /**
@@ -27,43 +28,70 @@ Token SeparateDelimetrArgs(const std::string& expression, const size_t curPos, s
 * @param[in] curPos - current position in expression to start separating
 * @param[out] endOfTokenPos - token end position
 */
-Token SeparateLiteral(const std::string& expression, const size_t curPos, size_t& endOfTokenPos) {
-  size_t delta = 0;
-  std::stod(expression.substr(curPos), &delta);
-  endOfTokenPos += delta;
+Token SeparateLiteral(std::string_view expression, const size_t curPos, size_t& endOfTokenPos) {
+  double value = 0;
+  auto result = std::from_chars(expression.data() + curPos, expression.data() + expression.size(), value);
+  if (result.ec != std::errc())
+    throw std::runtime_error("Invalid literal");
+  endOfTokenPos = result.ptr - expression.data();
   return Token(Token::Type::LITERAL, expression.substr(curPos, endOfTokenPos - curPos));
 }
 
 /**
 * @brief function to separate the named token from the current position
 * @details FUNCTION, OPERATOR, BRACKET or VARIABLE are called named token
+* @details the longest name wins, on equal length an operation's name is preferred to variable's name,
+* variable's name is interned, so every named token carries id of its name
 * @param[in] expression - expression to separate
+* @param[in] operations - operations whose names are known
 * @param[in] curPos - current position in expression to start separating
 * @param[out] endOfTokenPos - token end position
 */
-Token SeparateNamedToken(const std::string& expression, const size_t curPos, size_t& endOfTokenPos) {
-  OperationsDescription& operations = OperationsDescription::GetInstance();
-  for (endOfTokenPos; endOfTokenPos < expression.size() && !isspace(expression[endOfTokenPos]); ++endOfTokenPos);
-  for (endOfTokenPos; endOfTokenPos != curPos; endOfTokenPos--) {
-    std::string expressionPart = expression.substr(curPos, endOfTokenPos - curPos);
-    if (operations.CheckFunction(expressionPart))
-      return Token(Token::Type::FUNCTION, expressionPart);
-    if (operations.CheckOperator(expressionPart))
-      return Token(Token::Type::OPERATOR, expressionPart);
-    if (expressionPart == std::string{ SIMBOL_BEFORE_ARGS } || expressionPart == std::string{ SIMBOL_AFTER_ARGS } || 
-        operations.CheckBracket(expressionPart))
-      return Token(Token::Type::BRACKET, expressionPart);
-    if (Variable::IsValidValueName(expressionPart))
-      return Token(Token::Type::VARIABLE, expressionPart);
+Token SeparateNamedToken(std::string_view expression, const OperationsSnapshot& operations, const size_t curPos, size_t& endOfTokenPos) {
+  NameTrie::Kind kind = NameTrie::Kind::NONE;
+  uint32_t symbol = SymbolTable::NONE;
+  size_t nameLength = operations.MatchName(expression, curPos, kind, symbol);
+  if (nameLength == 0 && (expression[curPos] == SIMBOL_BEFORE_ARGS || expression[curPos] == SIMBOL_AFTER_ARGS)) {
+    kind = NameTrie::Kind::BRACKET;
+    nameLength = 1;
+  }
+
+  size_t variableLength = 0;
+  if (isalpha(expression[curPos]))
+    for (variableLength = 1; curPos + variableLength < expression.size() && isalnum(expression[curPos + variableLength]); ++variableLength);
+
+  if (variableLength > nameLength) {
+    endOfTokenPos = curPos + variableLength;
+    std::string_view name = expression.substr(curPos, variableLength);
+    return Token(Token::Type::VARIABLE, name, SymbolTable::GetInstance().Intern(name));
+  }
+  endOfTokenPos = curPos + nameLength;
+  switch (kind) {
+  case NameTrie::Kind::FUNCTION:
+    return Token(Token::Type::FUNCTION, expression.substr(curPos, nameLength), symbol);
+  case NameTrie::Kind::OPERATOR:
+    return Token(Token::Type::OPERATOR, expression.substr(curPos, nameLength), symbol);
+  case NameTrie::Kind::BRACKET:
+    return Token(Token::Type::BRACKET, expression.substr(curPos, nameLength), symbol);
+  default:
+    throw std::runtime_error("Unknown identifier");
   }
-  throw std::exception("Unknown identifier");
 }
 
 std::vector<Token> Separate(const std::string& expression) {
-  OperationsDescription& operations = OperationsDescription::GetInstance();
+  std::vector<Token> tokens = {};
+  Separate(expression, tokens);
+  return tokens;
+}
+
+void Separate(std::string_view expression, std::vector<Token>& tokens) {
+  Separate(expression, *OperationsDescription::GetInstance().GetSnapshot(), tokens);
+}
+
+void Separate(std::string_view expression, const OperationsSnapshot& operations, std::vector<Token>& tokens) {
   size_t curPos = 0;
   size_t endOfTokenPos = 0;
-  std::vector<Token> tokens = {};
+  tokens.clear();
 
   for (curPos = 0; curPos < expression.size(); curPos = endOfTokenPos)
     if (isspace(expression[curPos]))
@@ -73,7 +101,5 @@ std::vector<Token> Separate(const std::string& expression) {
     else if (isdigit(expression[curPos]))
       tokens.emplace_back(SeparateLiteral(expression, curPos, endOfTokenPos));
     else
-      tokens.emplace_back(SeparateNamedToken(expression, curPos, endOfTokenPos));
-  
-  return tokens;
+      tokens.emplace_back(SeparateNamedToken(expression, operations, curPos, endOfTokenPos));
 }
\ No newline at end of file
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <string>
-#include "..\..\Calculator\API\API.h"
+#include <string_view>
+#include "../../Calculator/API/API.h"
 
 /**
 * @brief token class
+* @details token does not own its string, it refers to the span of separated expression
 */
 class Token {
 public:
@@ -20,9 +22,10 @@ public:
   /**
   * @brief constructor
   * @param[in] type - token's type
-  * @param[in] token = token string
+  * @param[in] token - span of expression with token string
+  * @param[in] symbol - id of name in SymbolTable, SymbolTable::NONE for unnamed tokens
   */
-  Token(Type type, std::string token) : type(type), token(token) {};
+  Token(Type type, std::string_view token, uint32_t symbol = SymbolTable::NONE) : type(type), token(token), symbol(symbol) {};
 
   /**
   * @brief default copy constructor
@@ -59,11 +62,28 @@ public:
 
   /**
   * @brief getter token string
-  * @return token string
+  * @return span of expression with token string
   */
-  std::string GetName() const {
+  std::string_view GetName() const {
     return token;
   };
+
+  /**
+  * @brief getter of id of token's name
+  * @return id of name in SymbolTable, SymbolTable::NONE for unnamed tokens
+  */
+  uint32_t GetSymbol() const {
+    return symbol;
+  };
+
+  /**
+  * @brief method of comparing token with single character
+  * @param[in] simbol - character to compare
+  * @return true if token consists of this character only, false otherwise
+  */
+  bool IsSimbol(char simbol) const {
+    return token.size() == 1 && token[0] == simbol;
+  };
 private:
   /**
   * @brief type of token
@@ -71,14 +91,37 @@ private:
   const Type type;
 
   /**
-  * @brief token string
+  * @brief span of expression with token string
   */
-  const std::string token;
+  const std::string_view token;
+
+  /**
+  * @brief id of name in SymbolTable
+  */
+  const uint32_t symbol;
 };
 
 /**
 * @brief function of splitting an expression into tokens
 * @param[in] expression - expression in string form
 * @return expression in vector of token form
+* @warning tokens refer to expression, it must outlive them
+*/
+std::vector<Token> Separate(const std::string& expression);
+
+/**
+* @brief function of splitting an expression into tokens reusing the storage of tokens
+* @param[in] expression - expression in string form
+* @param[out] tokens - expression in vector of token form, previous content is cleared
+* @warning tokens refer to expression, it must outlive them
+*/
+void Separate(std::string_view expression, std::vector<Token>& tokens);
+
+/**
+* @brief function of splitting an expression into tokens with names of pinned snapshot of operations
+* @param[in] expression - expression in string form
+* @param[in] operations - operations whose names are known
+* @param[out] tokens - expression in vector of token form, previous content is cleared
+* @warning tokens refer to expression, it must outlive them
 */
-std::vector<Token> Separate(const std::string& expression);
\ No newline at end of file
+void Separate(std::string_view expression, const OperationsSnapshot& operations, std::vector<Token>& tokens);
\ No newline at end of file
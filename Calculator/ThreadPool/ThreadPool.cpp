@@ -0,0 +1,118 @@
+#include "ThreadPool.h"
+#include <exception>
+
+ThreadPool::ThreadPool(size_t threadsNum) {
+  if (threadsNum == 0)
+    threadsNum = std::thread::hardware_concurrency();
+  if (threadsNum == 0)
+    threadsNum = 1;
+  for (size_t i = 0; i < threadsNum; ++i)
+    queues.push_back(std::make_unique<Queue>());
+  for (size_t i = 0; i < threadsNum; ++i)
+    threads.emplace_back(&ThreadPool::Run, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    stop = true;
+  }
+  wake.notify_all();
+  for (auto& thread : threads)
+    thread.join();
+}
+
+size_t ThreadPool::GetThreadsCount(void) const {
+  return threads.size();
+}
+
+void ThreadPool::ParallelFor(size_t size, size_t grain, const RangeBody& body) {
+  if (size == 0)
+    return;
+  if (grain == 0)
+    grain = 1;
+
+  struct Job {
+    size_t remaining;
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+  } job;
+  size_t rangesNum = (size + grain - 1) / grain;
+  size_t workersNum = queues.size();
+  job.remaining = rangesNum;
+
+  //worker gets a contiguous run of ranges, so neighbouring rows stay on one core until they are stolen
+  for (size_t worker = 0; worker < workersNum; ++worker) {
+    size_t first = rangesNum * worker / workersNum;
+    size_t last = rangesNum * (worker + 1) / workersNum;
+    if (first == last)
+      continue;
+    std::lock_guard<std::mutex> lock(queues[worker]->mutex);
+    for (size_t range = last; range-- > first;) {
+      size_t begin = range * grain;
+      size_t end = begin + grain < size ? begin + grain : size;
+      queues[worker]->tasks.push_back([&job, &body, begin, end](size_t runner) {
+        try {
+          body(runner, begin, end);
+        }
+        catch (...) {
+          std::lock_guard<std::mutex> lock(job.mutex);
+          if (!job.error)
+            job.error = std::current_exception();
+        }
+        //job lives on the caller's stack, so it is released only after notification under the lock
+        std::lock_guard<std::mutex> lock(job.mutex);
+        if (--job.remaining == 0)
+          job.done.notify_all();
+      });
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    queued += rangesNum;
+  }
+  wake.notify_all();
+
+  std::unique_lock<std::mutex> lock(job.mutex);
+  job.done.wait(lock, [&job] { return job.remaining == 0; });
+  if (job.error)
+    std::rethrow_exception(job.error);
+}
+
+void ThreadPool::Run(size_t worker) {
+  Task task;
+  for (;;) {
+    if (Take(worker, task)) {
+      task(worker);
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    wake.wait(lock, [this] { return stop || queued > 0; });
+    if (stop && queued == 0)
+      return;
+  }
+}
+
+bool ThreadPool::Take(size_t worker, Task& task) {
+  size_t workersNum = queues.size();
+  for (size_t i = 0; i < workersNum; ++i) {
+    Queue& queue = *queues[(worker + i) % workersNum];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+      continue;
+    //own tasks are taken from the back, stolen ones from the front
+    if (i == 0) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    }
+    else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    --queued;
+    return true;
+  }
+  return false;
+}
\ No newline at end of file
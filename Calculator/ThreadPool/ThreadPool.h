@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+* @brief class of pool of worker threads with work stealing
+* @details every worker has its own queue of tasks, it takes tasks from the back of its queue
+* and, when the queue is empty, steals tasks from the front of queues of other workers
+*/
+class ThreadPool {
+public:
+  /**
+  * @brief signature of task, argument is index of worker which runs the task
+  */
+  using Task = std::function<void(size_t worker)>;
+
+  /**
+  * @brief signature of body of parallel loop
+  * @details arguments are index of worker which runs the body, first index of range and index after the last one
+  */
+  using RangeBody = std::function<void(size_t worker, size_t begin, size_t end)>;
+
+  /**
+  * @brief constructor, starts worker threads
+  * @param[in] threadsNum - number of worker threads, 0 means number of hardware threads
+  */
+  explicit ThreadPool(size_t threadsNum = 0);
+
+  /**
+  * @brief copy consructor (deleted)
+  * @warning the method is deleted
+  */
+  ThreadPool(const ThreadPool&) = delete;
+
+  /**
+  * @brief copy operator (deleted)
+  * @warning the operator is deleted
+  */
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+  * @brief destructor, waits for queued tasks and stops worker threads
+  */
+  ~ThreadPool();
+
+  /**
+  * @brief getter of number of worker threads
+  * @return number of worker threads
+  */
+  size_t GetThreadsCount(void) const;
+
+  /**
+  * @brief method of running loop over indexes [0, size) on worker threads
+  * @details indexes are split into ranges of grain indexes, ranges are spread evenly over workers' queues,
+  * the method returns when all ranges are done
+  * @param[in] size - number of indexes
+  * @param[in] grain - number of indexes in range
+  * @param[in] body - body of loop
+  * @throw first exception thrown by body, the rest ranges are still run
+  * @warning the method must not be called from a task of the same pool
+  */
+  void ParallelFor(size_t size, size_t grain, const RangeBody& body);
+private:
+  /**
+  * @brief struct of worker's queue
+  */
+  struct Queue {
+    std::mutex mutex;           ///< guard of tasks
+    std::deque<Task> tasks;     ///< tasks of worker
+  };
+
+  /**
+  * @brief method of worker thread
+  * @param[in] worker - index of worker
+  */
+  void Run(size_t worker);
+
+  /**
+  * @brief method of taking task from worker's queue or from queues of other workers
+  * @param[in] worker - index of worker
+  * @param[out] task - taken task
+  * @return true if task is taken, false otherwise
+  */
+  bool Take(size_t worker, Task& task);
+
+  /**
+  * @brief queues of workers
+  */
+  std::vector<std::unique_ptr<Queue>> queues;
+
+  /**
+  * @brief worker threads
+  */
+  std::vector<std::thread> threads;
+
+  /**
+  * @brief number of tasks in all queues
+  */
+  std::atomic<size_t> queued{ 0 };
+
+  /**
+  * @brief guard of sleeping workers
+  */
+  std::mutex wakeMutex;
+
+  /**
+  * @brief condition of new tasks or stop
+  */
+  std::condition_variable wake;
+
+  /**
+  * @brief flag of stopping workers
+  */
+  bool stop = false;
+};
\ No newline at end of file
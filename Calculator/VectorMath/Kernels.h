@@ -0,0 +1,375 @@
+#pragma once
+
+#include "VectorMath.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+/**
+* @brief class of kernels written once for any lane type
+* @details lane type V describes a SIMD register of V::WIDTH doubles: Type, Mask, Load, Store, Set, SetBits,
+* Add, Sub, Mul, Div, Max, MulAdd, TwoProd, And, Or, Xor, AddInt, SubInt, ShiftLeft, ShiftRight,
+* Less, LessEqual, GreaterEqual, Blend and MaskBits.
+* Every translation unit instantiates the class with its own lane type, so code built for wider
+* instruction sets is never shared with narrower ones. The header must not define non-template functions for the same reason.
+*/
+template <typename V>
+class LaneMath {
+public:
+  using Type = typename V::Type;
+
+  static void Add(const double* a, const double* b, double* out, size_t n) {
+    Map2(a, b, out, n, [](Type x, Type y, unsigned&) { return V::Add(x, y); }, [](double x, double y) { return x + y; });
+  }
+
+  static void Sub(const double* a, const double* b, double* out, size_t n) {
+    Map2(a, b, out, n, [](Type x, Type y, unsigned&) { return V::Sub(x, y); }, [](double x, double y) { return x - y; });
+  }
+
+  static void Mul(const double* a, const double* b, double* out, size_t n) {
+    Map2(a, b, out, n, [](Type x, Type y, unsigned&) { return V::Mul(x, y); }, [](double x, double y) { return x * y; });
+  }
+
+  static void Div(const double* a, const double* b, double* out, size_t n) {
+    Map2(a, b, out, n, [](Type x, Type y, unsigned&) { return V::Div(x, y); }, [](double x, double y) { return x / y; });
+  }
+
+  static void Max(const double* a, const double* b, double* out, size_t n) {
+    Map2(a, b, out, n, [](Type x, Type y, unsigned&) { return V::Max(x, y); }, [](double x, double y) { return x > y ? x : y; });
+  }
+
+  static void Neg(const double* a, double* out, size_t n) {
+    Map1(a, out, n, [](Type x, unsigned&) { return V::Xor(x, V::SetBits(SIGN_MASK)); }, [](double x) { return -x; });
+  }
+
+  static void Sin(const double* a, double* out, size_t n) {
+    Map1(a, out, n, [](Type x, unsigned& invalid) {
+      Type sin, cos, quadrant;
+      invalid = SinCos(x, sin, cos, quadrant);
+      Type sign = V::ShiftLeft(V::And(quadrant, V::SetBits(2)), 62);
+      return V::Xor(V::Blend(IsOdd(quadrant), sin, cos), sign);
+    }, [](double x) { return std::sin(x); });
+  }
+
+  static void Cos(const double* a, double* out, size_t n) {
+    Map1(a, out, n, [](Type x, unsigned& invalid) {
+      Type sin, cos, quadrant;
+      invalid = SinCos(x, sin, cos, quadrant);
+      Type sign = V::ShiftLeft(V::And(V::AddInt(quadrant, V::SetBits(1)), V::SetBits(2)), 62);
+      return V::Xor(V::Blend(IsOdd(quadrant), cos, sin), sign);
+    }, [](double x) { return std::cos(x); });
+  }
+
+  static void Tan(const double* a, double* out, size_t n) {
+    Map1(a, out, n, [](Type x, unsigned& invalid) {
+      Type sin, cos, quadrant;
+      invalid = SinCos(x, sin, cos, quadrant);
+      auto odd = IsOdd(quadrant);
+      Type sign = V::ShiftLeft(V::And(quadrant, V::SetBits(1)), 63);
+      return V::Xor(V::Div(V::Blend(odd, sin, cos), V::Blend(odd, cos, sin)), sign);
+    }, [](double x) { return std::tan(x); });
+  }
+
+  static void Exp(const double* a, double* out, size_t n) {
+    Map1(a, out, n, [](Type x, unsigned& invalid) {
+      invalid = ~V::MaskBits(V::LessEqual(Abs(x), V::Set(EXP_LIMIT)));
+      return ExpKernel(x);
+    }, [](double x) { return std::exp(x); });
+  }
+
+  static void Log(const double* a, double* out, size_t n) {
+    Map1(a, out, n, [](Type x, unsigned& invalid) {
+      invalid = ~(V::MaskBits(V::GreaterEqual(x, V::Set(MIN_NORMAL))) & V::MaskBits(V::LessEqual(x, V::Set(MAX_FINITE))));
+      Type lo;
+      return LogKernel(x, lo, false);
+    }, [](double x) { return std::log(x); });
+  }
+
+  static void Pow(const double* a, const double* b, double* out, size_t n) {
+    Map2(a, b, out, n, [](Type x, Type y, unsigned& invalid) {
+      Type lo;
+      Type hi = LogKernel(x, lo, true);
+      Type productLo;
+      Type product = V::TwoProd(y, hi, productLo);
+      productLo = V::MulAdd(y, lo, productLo);
+      invalid = ~(V::MaskBits(V::GreaterEqual(x, V::Set(MIN_NORMAL))) & V::MaskBits(V::LessEqual(x, V::Set(MAX_FINITE))) &
+                  V::MaskBits(V::LessEqual(Abs(y), V::Set(MAX_FINITE))) & V::MaskBits(V::LessEqual(Abs(product), V::Set(POW_LIMIT))));
+      Type exp = ExpKernel(product);
+      return V::MulAdd(exp, productLo, exp);
+    }, [](double x, double y) { return std::pow(x, y); });
+  }
+
+  /**
+  * @brief method of making kernel's table
+  * @param[in] isa - instruction set
+  * @param[in] name - name of instruction set
+  * @return kernel's table
+  */
+  static VectorKernels MakeKernels(VectorIsa isa, const char* name) {
+    return { isa, name, Add, Sub, Mul, Div, Max, Neg, Sin, Cos, Tan, Exp, Log, Pow };
+  }
+private:
+  static constexpr uint64_t SIGN_MASK = 0x8000000000000000ull;
+  static constexpr uint64_t ABS_MASK = 0x7FFFFFFFFFFFFFFFull;
+  static constexpr uint64_t MANTISSA_MASK = 0x000FFFFFFFFFFFFFull;
+  static constexpr uint64_t ONE_BITS = 0x3FF0000000000000ull;
+  static constexpr double SHIFT = 6755399441055744.0;                 //1.5 * 2^52, rounds to integer when added
+  static constexpr uint64_t SHIFT_BITS = 0x4338000000000000ull;
+  static constexpr double TWO52 = 4503599627370496.0;
+  static constexpr uint64_t TWO52_BITS = 0x4330000000000000ull;
+  static constexpr double MIN_NORMAL = 2.2250738585072014e-308;
+  static constexpr double MAX_FINITE = 1.7976931348623157e+308;
+  static constexpr double EXP_LIMIT = 708.0;
+  static constexpr double POW_LIMIT = 32.0;                           //error of logarithm in pow grows with b*ln(a) beyond 2 ulp
+  static constexpr double LOG2E = 1.4426950408889634;
+  static constexpr double LN2_HI = 6.93147180369123816490e-01;     //33 significant bits
+  static constexpr double LN2_LO = 1.90821492927058770002e-10;
+  static constexpr double SQRT2 = 1.4142135623730951;
+  static constexpr double TWO_OVER_PI = 6.36619772367581382433e-01;
+  static constexpr double PIO2_1 = 1.57079632673412561417e+00;     //33 significant bits of pi/2
+  static constexpr double PIO2_2 = 6.07710050630396597660e-11;     //next 33 bits
+  static constexpr double PIO2_2T = 2.02226624879595063154e-21;
+  static constexpr double PIO2_3 = 2.02226624871116645580e-21;     //next 33 bits
+  static constexpr double PIO2_3T = 8.47842766036889956997e-32;
+  static constexpr double TRIG_LIMIT = 1e6;
+  static constexpr double TINY = 7.450580596923828125e-9;             //2^-27, sin(x) rounds to x below it
+
+  static Type Abs(Type x) {
+    return V::And(x, V::SetBits(ABS_MASK));
+  }
+
+  /**
+  * @brief method of converting small non-negative integers stored in lanes to doubles
+  * @param[in] x - integers less than 2^52
+  * @return doubles
+  */
+  static Type ToDouble(Type x) {
+    return V::Sub(V::Or(x, V::SetBits(TWO52_BITS)), V::Set(TWO52));
+  }
+
+  /**
+  * @brief method of check that quarter of period is odd
+  * @param[in] quadrant - number of quarters of period stored as integers
+  * @return mask of odd quadrants
+  */
+  static typename V::Mask IsOdd(Type quadrant) {
+    return V::Less(V::Set(0.5), ToDouble(V::And(quadrant, V::SetBits(1))));
+  }
+
+  /**
+  * @brief method of computing exp for |x| <= EXP_LIMIT
+  * @details x = n*ln2 + r with |r| <= ln2/2, exp(r) = 1 + r + r^2*q(r) where q is Taylor polynomial of degree 11
+  */
+  static Type ExpKernel(Type x) {
+    Type t = V::MulAdd(x, V::Set(LOG2E), V::Set(SHIFT));
+    Type n = V::Sub(t, V::Set(SHIFT));
+    Type r = V::MulAdd(n, V::Set(-LN2_HI), x);
+    r = V::MulAdd(n, V::Set(-LN2_LO), r);
+
+    Type q = V::Set(1.0 / 6227020800.0);
+    q = V::MulAdd(q, r, V::Set(1.0 / 479001600.0));
+    q = V::MulAdd(q, r, V::Set(1.0 / 39916800.0));
+    q = V::MulAdd(q, r, V::Set(1.0 / 3628800.0));
+    q = V::MulAdd(q, r, V::Set(1.0 / 362880.0));
+    q = V::MulAdd(q, r, V::Set(1.0 / 40320.0));
+    q = V::MulAdd(q, r, V::Set(1.0 / 5040.0));
+    q = V::MulAdd(q, r, V::Set(1.0 / 720.0));
+    q = V::MulAdd(q, r, V::Set(1.0 / 120.0));
+    q = V::MulAdd(q, r, V::Set(1.0 / 24.0));
+    q = V::MulAdd(q, r, V::Set(1.0 / 6.0));
+    q = V::MulAdd(q, r, V::Set(0.5));
+    Type exp = V::Add(V::Set(1.0), V::MulAdd(V::Mul(r, r), q, r));
+
+    //2^n is built from exponent bits, n is in low bits of t
+    Type scale = V::ShiftLeft(V::SubInt(t, V::SetBits(SHIFT_BITS - 1023)), 52);
+    return V::Mul(exp, scale);
+  }
+
+  /**
+  * @brief method of computing natural logarithm for positive normal finite x
+  * @details x = 2^k*m with sqrt(2)/2 < m <= sqrt(2), log(m) is computed as in fdlibm through s = (m-1)/(m+1)
+  * @param[in] x - argument
+  * @param[out] lo - low part of result if extended precision is requested
+  * @param[in] extended - true if result is needed as unevaluated sum of result and lo
+  */
+  static Type LogKernel(Type x, Type& lo, bool extended) {
+    const double LG1 = 6.666666666666735130e-01, LG2 = 3.999999999940941908e-01, LG3 = 2.857142874366239149e-01,
+      LG4 = 2.222219843214978396e-01, LG5 = 1.818357216161805012e-01, LG6 = 1.531383769920937332e-01, LG7 = 1.479819860511658591e-01;
+
+    Type k = V::Sub(ToDouble(V::ShiftRight(x, 52)), V::Set(1023));
+    Type m = V::Or(V::And(x, V::SetBits(MANTISSA_MASK)), V::SetBits(ONE_BITS));
+    auto big = V::Less(V::Set(SQRT2), m);
+    m = V::Blend(big, m, V::Mul(m, V::Set(0.5)));
+    k = V::Blend(big, k, V::Add(k, V::Set(1)));
+
+    Type f = V::Sub(m, V::Set(1));
+    Type s = V::Div(f, V::Add(V::Set(2), f));
+    Type z = V::Mul(s, s);
+    Type w = V::Mul(z, z);
+    Type t1 = V::Mul(w, V::MulAdd(w, V::MulAdd(w, V::Set(LG6), V::Set(LG4)), V::Set(LG2)));
+    Type t2 = V::Mul(z, V::MulAdd(w, V::MulAdd(w, V::MulAdd(w, V::Set(LG7), V::Set(LG5)), V::Set(LG3)), V::Set(LG1)));
+    Type r = V::Add(t2, t1);
+
+    if (!extended) {
+      Type hfsq = V::Mul(V::Set(0.5), V::Mul(f, f));
+      Type tail = V::MulAdd(k, V::Set(LN2_LO), V::Mul(s, V::Add(hfsq, r)));
+      return V::MulAdd(k, V::Set(LN2_HI), V::Sub(f, V::Sub(hfsq, tail)));
+    }
+
+    //log(m) = f - hfsq + s*(hfsq + r), kept as sum of two doubles,
+    //s*(hfsq + r) reaches 0.02, so s and hfsq + r are also kept with low parts, since pow multiplies their rounding errors
+    Type hfsqLo;
+    Type hfsq = V::TwoProd(f, f, hfsqLo);
+    hfsq = V::Mul(hfsq, V::Set(0.5));
+    hfsqLo = V::Mul(hfsqLo, V::Set(0.5));
+    Type d = V::Add(V::Set(2), f);
+    Type dLo = V::Add(V::Sub(V::Set(2), d), f);
+    Type sdLo;
+    Type sd = V::TwoProd(s, d, sdLo);
+    Type sLo = V::Div(V::Sub(V::Sub(V::Sub(f, sd), sdLo), V::Mul(s, dLo)), d);
+    Type h = V::Add(hfsq, r);
+    Type hLo = V::Add(V::Add(V::Sub(hfsq, h), r), hfsqLo);
+    Type termLo;
+    Type term = V::TwoProd(s, h, termLo);
+    termLo = V::Add(termLo, V::MulAdd(s, hLo, V::Mul(sLo, h)));
+
+    Type a = V::Sub(f, hfsq);
+    Type aLo = V::Sub(V::Sub(V::Sub(f, a), hfsq), hfsqLo);
+    Type b = V::Add(a, term);
+    aLo = V::Add(V::Add(V::Add(V::Sub(a, b), term), aLo), termLo);
+    a = b;
+
+    Type kHi = V::Mul(k, V::Set(LN2_HI));
+    Type sum = V::Add(kHi, a);
+    Type virtualA = V::Sub(sum, kHi);
+    Type sumLo = V::Add(V::Sub(kHi, V::Sub(sum, virtualA)), V::Sub(a, virtualA));
+    sumLo = V::Add(sumLo, V::MulAdd(k, V::Set(LN2_LO), aLo));
+    Type hi = V::Add(sum, sumLo);
+    lo = V::Sub(sumLo, V::Sub(hi, sum));
+    return hi;
+  }
+
+  /**
+  * @brief method of computing sin and cos of reduced argument
+  * @details x = n*pi/2 + r with |r| <= pi/4, pi/2 is split into three parts as in fdlibm, polynomials are from fdlibm
+  * @param[in] x - argument
+  * @param[out] sin - sin(r)
+  * @param[out] cos - cos(r)
+  * @param[out] quadrant - n stored as integers
+  * @return bits of lanes which must be computed by C library
+  */
+  static unsigned SinCos(Type x, Type& sin, Type& cos, Type& quadrant) {
+    const double S1 = -1.66666666666666324348e-01, S2 = 8.33333333332248946124e-03, S3 = -1.98412698298579493134e-04,
+      S4 = 2.75573137070700676789e-06, S5 = -2.50507602534068634195e-08, S6 = 1.58969099521155010221e-10;
+    const double C1 = 4.16666666666666019037e-02, C2 = -1.38888888888741095749e-03, C3 = 2.48015872894767294178e-05,
+      C4 = -2.75573143513906633035e-07, C5 = 2.08757232129817482790e-09, C6 = -1.13596475577881948265e-11;
+
+    Type t = V::MulAdd(x, V::Set(TWO_OVER_PI), V::Set(SHIFT));
+    Type n = V::Sub(t, V::Set(SHIFT));
+    quadrant = V::SubInt(t, V::SetBits(SHIFT_BITS));
+
+    Type r = V::Sub(x, V::Mul(n, V::Set(PIO2_1)));
+    Type w, y;
+    //the first part of pi/2 gives exact product, the rest is subtracted keeping rounding error as in fdlibm
+    const double parts[][2] = { { PIO2_2, PIO2_2T }, { PIO2_3, PIO2_3T } };
+    for (auto& part : parts) {
+      Type previous = r;
+      w = V::Mul(n, V::Set(part[0]));
+      r = V::Sub(previous, w);
+      w = V::Sub(V::Mul(n, V::Set(part[1])), V::Sub(V::Sub(previous, r), w));
+      y = V::Sub(r, w);
+    }
+
+    Type tail = V::Sub(V::Sub(r, y), w);
+
+    //polynomials take reduced argument as y + tail
+    Type z = V::Mul(y, y);
+    Type v = V::Mul(z, y);
+    Type p = V::MulAdd(z, V::MulAdd(z, V::MulAdd(z, V::MulAdd(z, V::Set(S6), V::Set(S5)), V::Set(S4)), V::Set(S3)), V::Set(S2));
+    Type s = V::Sub(V::Mul(z, V::Sub(V::Mul(V::Set(0.5), tail), V::Mul(v, p))), tail);
+    sin = V::Sub(y, V::Sub(s, V::Mul(v, V::Set(S1))));
+    sin = V::Blend(V::Less(Abs(y), V::Set(TINY)), sin, y);
+
+    Type q = V::Mul(z, V::MulAdd(z, V::MulAdd(z, V::MulAdd(z, V::MulAdd(z, V::MulAdd(z, V::Set(C6), V::Set(C5)), V::Set(C4)), V::Set(C3)), V::Set(C2)), V::Set(C1)));
+    Type hz = V::Mul(V::Set(0.5), z);
+    Type one = V::Set(1);
+    Type c = V::Sub(one, hz);
+    cos = V::Add(c, V::Add(V::Sub(V::Sub(one, c), hz), V::Sub(V::Mul(z, q), V::Mul(y, tail))));
+
+    return ~V::MaskBits(V::LessEqual(Abs(x), V::Set(TRIG_LIMIT)));
+  }
+
+  /**
+  * @brief method of applying lane kernel of one argument to array
+  * @param[in] kernel - lane kernel, sets bits of lanes it can not compute
+  * @param[in] fallback - scalar function for such lanes
+  */
+  template <typename Kernel, typename Fallback>
+  static void Map1(const double* a, double* out, size_t n, Kernel kernel, Fallback fallback) {
+    auto block = [&](const double* x, double* result) {
+      unsigned invalid = 0;
+      Type values = kernel(V::Load(x), invalid);
+      invalid &= (1u << V::WIDTH) - 1;
+      if (invalid == 0) {
+        V::Store(result, values);
+        return;
+      }
+      //result may be the argument, so lanes are fixed in local copy before arguments are overwritten
+      double fixed[V::WIDTH];
+      V::Store(fixed, values);
+      for (size_t j = 0; invalid != 0; ++j, invalid >>= 1)
+        if (invalid & 1)
+          fixed[j] = fallback(x[j]);
+      std::copy_n(fixed, V::WIDTH, result);
+    };
+    size_t i = 0;
+    for (; i + V::WIDTH <= n; i += V::WIDTH)
+      block(a + i, out + i);
+    if (i < n) {
+      double x[V::WIDTH], result[V::WIDTH];
+      for (size_t j = 0; j < V::WIDTH; ++j)
+        x[j] = i + j < n ? a[i + j] : 1;
+      block(x, result);
+      for (size_t j = 0; i + j < n; ++j)
+        out[i + j] = result[j];
+    }
+  }
+
+  /**
+  * @brief method of applying lane kernel of two arguments to arrays
+  * @param[in] kernel - lane kernel, sets bits of lanes it can not compute
+  * @param[in] fallback - scalar function for such lanes
+  */
+  template <typename Kernel, typename Fallback>
+  static void Map2(const double* a, const double* b, double* out, size_t n, Kernel kernel, Fallback fallback) {
+    auto block = [&](const double* x, const double* y, double* result) {
+      unsigned invalid = 0;
+      Type values = kernel(V::Load(x), V::Load(y), invalid);
+      invalid &= (1u << V::WIDTH) - 1;
+      if (invalid == 0) {
+        V::Store(result, values);
+        return;
+      }
+      //result may be one of arguments, so lanes are fixed in local copy before arguments are overwritten
+      double fixed[V::WIDTH];
+      V::Store(fixed, values);
+      for (size_t j = 0; invalid != 0; ++j, invalid >>= 1)
+        if (invalid & 1)
+          fixed[j] = fallback(x[j], y[j]);
+      std::copy_n(fixed, V::WIDTH, result);
+    };
+    size_t i = 0;
+    for (; i + V::WIDTH <= n; i += V::WIDTH)
+      block(a + i, b + i, out + i);
+    if (i < n) {
+      double x[V::WIDTH], y[V::WIDTH], result[V::WIDTH];
+      for (size_t j = 0; j < V::WIDTH; ++j) {
+        x[j] = i + j < n ? a[i + j] : 1;
+        y[j] = i + j < n ? b[i + j] : 1;
+      }
+      block(x, y, result);
+      for (size_t j = 0; i + j < n; ++j)
+        out[i + j] = result[j];
+    }
+  }
+};
\ No newline at end of file
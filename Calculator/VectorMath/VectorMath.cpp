@@ -0,0 +1,149 @@
+#include "Kernels.h"
+#include <cstring>
+#include <initializer_list>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VECTOR_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+/**
+* @brief lane type of one double for portable kernels
+*/
+struct ScalarLane {
+  using Type = double;
+  using Mask = bool;
+  static constexpr size_t WIDTH = 1;
+
+  static Type Load(const double* data) { return *data; }
+  static void Store(double* data, Type a) { *data = a; }
+  static Type Set(double value) { return value; }
+  static Type SetBits(uint64_t bits) { return FromBits(bits); }
+  static Type Add(Type a, Type b) { return a + b; }
+  static Type Sub(Type a, Type b) { return a - b; }
+  static Type Mul(Type a, Type b) { return a * b; }
+  static Type Div(Type a, Type b) { return a / b; }
+  static Type Max(Type a, Type b) { return a > b ? a : b; }
+  static Type MulAdd(Type a, Type b, Type c) { return a * b + c; }
+  static Type TwoProd(Type a, Type b, Type& error) {
+    const double SPLITTER = 134217729.0;   //2^27 + 1
+    double product = a * b;
+    double ca = SPLITTER * a, cb = SPLITTER * b;
+    double aHi = ca - (ca - a), bHi = cb - (cb - b);
+    double aLo = a - aHi, bLo = b - bHi;
+    error = ((aHi * bHi - product) + aHi * bLo + aLo * bHi) + aLo * bLo;
+    return product;
+  }
+  static Type And(Type a, Type b) { return FromBits(ToBits(a) & ToBits(b)); }
+  static Type Or(Type a, Type b) { return FromBits(ToBits(a) | ToBits(b)); }
+  static Type Xor(Type a, Type b) { return FromBits(ToBits(a) ^ ToBits(b)); }
+  static Type AddInt(Type a, Type b) { return FromBits(ToBits(a) + ToBits(b)); }
+  static Type SubInt(Type a, Type b) { return FromBits(ToBits(a) - ToBits(b)); }
+  static Type ShiftLeft(Type a, int count) { return FromBits(ToBits(a) << count); }
+  static Type ShiftRight(Type a, int count) { return FromBits(ToBits(a) >> count); }
+  static Mask Less(Type a, Type b) { return a < b; }
+  static Mask LessEqual(Type a, Type b) { return a <= b; }
+  static Mask GreaterEqual(Type a, Type b) { return a >= b; }
+  static Type Blend(Mask mask, Type a, Type b) { return mask ? b : a; }
+  static unsigned MaskBits(Mask mask) { return mask ? 1 : 0; }
+
+  static uint64_t ToBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+  static double FromBits(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+};
+
+#ifdef VECTOR_X86
+const VectorKernels* GetSse2Kernels(void);
+const VectorKernels* GetAvx2Kernels(void);
+const VectorKernels* GetAvx512Kernels(void);
+
+/**
+* @brief function of check that processor and operating system support instruction set
+* @param[in] isa - instruction set
+* @return true if instruction set may be used, false otherwise
+*/
+bool IsSupported(VectorIsa isa) {
+#if defined(__GNUC__)
+  __builtin_cpu_init();
+  switch (isa) {
+  case VectorIsa::SSE2:
+    return __builtin_cpu_supports("sse2");
+  case VectorIsa::AVX2:
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  case VectorIsa::AVX512:
+    return __builtin_cpu_supports("avx512f");
+  default:
+    return true;
+  }
+#elif defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  int maxLeaf = info[0];
+  __cpuid(info, 1);
+  bool sse2 = (info[3] & (1 << 26)) != 0;
+  bool fma = (info[2] & (1 << 12)) != 0;
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+  bool avxState = (xcr0 & 0x6) == 0x6;
+  bool avx512State = (xcr0 & 0xE6) == 0xE6;
+  bool avx2 = false, avx512 = false;
+  if (maxLeaf >= 7) {
+    __cpuidex(info, 7, 0);
+    avx2 = (info[1] & (1 << 5)) != 0;
+    avx512 = (info[1] & (1 << 16)) != 0;
+  }
+  switch (isa) {
+  case VectorIsa::SSE2:
+    return sse2;
+  case VectorIsa::AVX2:
+    return avx2 && fma && avxState;
+  case VectorIsa::AVX512:
+    return avx512 && avx512State;
+  default:
+    return true;
+  }
+#else
+  return isa == VectorIsa::SCALAR;
+#endif
+}
+#endif
+
+const VectorKernels* GetVectorKernels(VectorIsa isa) {
+  static const VectorKernels scalar = LaneMath<ScalarLane>::MakeKernels(VectorIsa::SCALAR, "scalar");
+  if (isa == VectorIsa::SCALAR)
+    return &scalar;
+#ifdef VECTOR_X86
+  if (!IsSupported(isa))
+    return nullptr;
+  switch (isa) {
+  case VectorIsa::SSE2:
+    return GetSse2Kernels();
+  case VectorIsa::AVX2:
+    return GetAvx2Kernels();
+  case VectorIsa::AVX512:
+    return GetAvx512Kernels();
+  default:
+    break;
+  }
+#endif
+  return nullptr;
+}
+
+const VectorKernels& GetVectorKernels(void) {
+  static const VectorKernels* best = []() {
+    for (VectorIsa isa : { VectorIsa::AVX512, VectorIsa::AVX2, VectorIsa::SSE2 })
+      if (auto kernels = GetVectorKernels(isa))
+        return kernels;
+    return GetVectorKernels(VectorIsa::SCALAR);
+  }();
+  return *best;
+}
\ No newline at end of file
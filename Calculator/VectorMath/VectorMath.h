@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+* @brief enum class of instruction sets which kernels are built for
+*/
+enum class VectorIsa {
+  SCALAR,   ///< portable code, one value at a time
+  SSE2,     ///< 2 values at a time
+  AVX2,     ///< 4 values at a time, requires AVX2 and FMA
+  AVX512,   ///< 8 values at a time, requires AVX-512F
+};
+
+/**
+* @brief table of kernels over arrays of doubles
+* @details every kernel reads n values from each argument array and writes n results to out, out may be equal to an argument.
+* Error of polynomial approximations measured on random arguments against extended precision:
+* exp - below 1 ulp for |x| <= 708, log - below 1 ulp, sin and cos - below 2 ulp for |x| <= 1e6,
+* tan - below 3.5 ulp for |x| <= 1e6, pow - below 2.5 ulp while |b*ln(a)| <= 32, the bounds are checked by VectorMathChecks.
+* Arguments out of these ranges, not finite, non-positive arguments of log and pow and subnormal ones are passed to the C library.
+*/
+struct VectorKernels {
+  /**
+  * @brief signature of kernel of one argument
+  */
+  using UnaryKernel = void(*)(const double* a, double* out, size_t n);
+
+  /**
+  * @brief signature of kernel of two arguments
+  */
+  using BinaryKernel = void(*)(const double* a, const double* b, double* out, size_t n);
+
+  VectorIsa isa;        ///< instruction set
+  const char* name;     ///< name of instruction set
+  BinaryKernel add;     ///< a + b
+  BinaryKernel sub;     ///< a - b
+  BinaryKernel mul;     ///< a * b
+  BinaryKernel div;     ///< a / b
+  BinaryKernel max;     ///< a > b ? a : b
+  UnaryKernel neg;      ///< -a
+  UnaryKernel sin;      ///< sin(a)
+  UnaryKernel cos;      ///< cos(a)
+  UnaryKernel tan;      ///< tan(a)
+  UnaryKernel exp;      ///< exp(a)
+  UnaryKernel log;      ///< natural logarithm of a
+  BinaryKernel pow;     ///< a raised to the power b
+};
+
+/**
+* @brief getter of kernels for instruction set
+* @param[in] isa - instruction set
+* @return kernels, nullptr if instruction set is not supported by build or processor
+*/
+const VectorKernels* GetVectorKernels(VectorIsa isa);
+
+/**
+* @brief getter of kernels for the widest instruction set supported by processor
+* @details processor features are detected once, at the first call
+* @return kernels
+*/
+const VectorKernels& GetVectorKernels(void);
\ No newline at end of file
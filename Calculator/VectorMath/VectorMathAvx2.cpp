@@ -0,0 +1,51 @@
+#include "Kernels.h"
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+
+/**
+* @brief lane type of 4 doubles in AVX register
+*/
+struct Avx2Lane {
+  using Type = __m256d;
+  using Mask = __m256d;
+  static constexpr size_t WIDTH = 4;
+
+  static Type Load(const double* data) { return _mm256_loadu_pd(data); }
+  static void Store(double* data, Type a) { _mm256_storeu_pd(data, a); }
+  static Type Set(double value) { return _mm256_set1_pd(value); }
+  static Type SetBits(uint64_t bits) { return _mm256_castsi256_pd(_mm256_set1_epi64x((long long)bits)); }
+  static Type Add(Type a, Type b) { return _mm256_add_pd(a, b); }
+  static Type Sub(Type a, Type b) { return _mm256_sub_pd(a, b); }
+  static Type Mul(Type a, Type b) { return _mm256_mul_pd(a, b); }
+  static Type Div(Type a, Type b) { return _mm256_div_pd(a, b); }
+  static Type Max(Type a, Type b) { return _mm256_max_pd(a, b); }
+  static Type MulAdd(Type a, Type b, Type c) { return _mm256_fmadd_pd(a, b, c); }
+  static Type TwoProd(Type a, Type b, Type& error) {
+    Type product = Mul(a, b);
+    error = _mm256_fmsub_pd(a, b, product);
+    return product;
+  }
+  static Type And(Type a, Type b) { return _mm256_and_pd(a, b); }
+  static Type Or(Type a, Type b) { return _mm256_or_pd(a, b); }
+  static Type Xor(Type a, Type b) { return _mm256_xor_pd(a, b); }
+  static Type AddInt(Type a, Type b) { return _mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(a), _mm256_castpd_si256(b))); }
+  static Type SubInt(Type a, Type b) { return _mm256_castsi256_pd(_mm256_sub_epi64(_mm256_castpd_si256(a), _mm256_castpd_si256(b))); }
+  static Type ShiftLeft(Type a, int count) { return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(a), count)); }
+  static Type ShiftRight(Type a, int count) { return _mm256_castsi256_pd(_mm256_srli_epi64(_mm256_castpd_si256(a), count)); }
+  static Mask Less(Type a, Type b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+  static Mask LessEqual(Type a, Type b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+  static Mask GreaterEqual(Type a, Type b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+  static Type Blend(Mask mask, Type a, Type b) { return _mm256_blendv_pd(a, b, mask); }
+  static unsigned MaskBits(Mask mask) { return (unsigned)_mm256_movemask_pd(mask); }
+};
+
+const VectorKernels* GetAvx2Kernels(void) {
+  static const VectorKernels kernels = LaneMath<Avx2Lane>::MakeKernels(VectorIsa::AVX2, "avx2");
+  return &kernels;
+}
+#else
+const VectorKernels* GetAvx2Kernels(void) {
+  return nullptr;
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "Kernels.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+/**
+* @brief lane type of 8 doubles in AVX-512 register
+*/
+struct Avx512Lane {
+  using Type = __m512d;
+  using Mask = __mmask8;
+  static constexpr size_t WIDTH = 8;
+
+  static Type Load(const double* data) { return _mm512_loadu_pd(data); }
+  static void Store(double* data, Type a) { _mm512_storeu_pd(data, a); }
+  static Type Set(double value) { return _mm512_set1_pd(value); }
+  static Type SetBits(uint64_t bits) { return _mm512_castsi512_pd(_mm512_set1_epi64((long long)bits)); }
+  static Type Add(Type a, Type b) { return _mm512_add_pd(a, b); }
+  static Type Sub(Type a, Type b) { return _mm512_sub_pd(a, b); }
+  static Type Mul(Type a, Type b) { return _mm512_mul_pd(a, b); }
+  static Type Div(Type a, Type b) { return _mm512_div_pd(a, b); }
+  static Type Max(Type a, Type b) { return _mm512_max_pd(a, b); }
+  static Type MulAdd(Type a, Type b, Type c) { return _mm512_fmadd_pd(a, b, c); }
+  static Type TwoProd(Type a, Type b, Type& error) {
+    Type product = Mul(a, b);
+    error = _mm512_fmsub_pd(a, b, product);
+    return product;
+  }
+  static Type And(Type a, Type b) { return Integer(_mm512_and_si512(Integer(a), Integer(b))); }
+  static Type Or(Type a, Type b) { return Integer(_mm512_or_si512(Integer(a), Integer(b))); }
+  static Type Xor(Type a, Type b) { return Integer(_mm512_xor_si512(Integer(a), Integer(b))); }
+  static Type AddInt(Type a, Type b) { return Integer(_mm512_add_epi64(Integer(a), Integer(b))); }
+  static Type SubInt(Type a, Type b) { return Integer(_mm512_sub_epi64(Integer(a), Integer(b))); }
+  static Type ShiftLeft(Type a, int count) { return Integer(_mm512_slli_epi64(Integer(a), count)); }
+  static Type ShiftRight(Type a, int count) { return Integer(_mm512_srli_epi64(Integer(a), count)); }
+  static Mask Less(Type a, Type b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+  static Mask LessEqual(Type a, Type b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+  static Mask GreaterEqual(Type a, Type b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+  static Type Blend(Mask mask, Type a, Type b) { return _mm512_mask_blend_pd(mask, a, b); }
+  static unsigned MaskBits(Mask mask) { return (unsigned)mask; }
+
+  static __m512i Integer(Type a) { return _mm512_castpd_si512(a); }
+  static Type Integer(__m512i a) { return _mm512_castsi512_pd(a); }
+};
+
+const VectorKernels* GetAvx512Kernels(void) {
+  static const VectorKernels kernels = LaneMath<Avx512Lane>::MakeKernels(VectorIsa::AVX512, "avx512");
+  return &kernels;
+}
+#else
+const VectorKernels* GetAvx512Kernels(void) {
+  return nullptr;
+}
+#endif
\ No newline at end of file
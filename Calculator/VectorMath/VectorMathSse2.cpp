@@ -0,0 +1,55 @@
+#include "Kernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+
+/**
+* @brief lane type of 2 doubles in SSE2 register
+*/
+struct Sse2Lane {
+  using Type = __m128d;
+  using Mask = __m128d;
+  static constexpr size_t WIDTH = 2;
+
+  static Type Load(const double* data) { return _mm_loadu_pd(data); }
+  static void Store(double* data, Type a) { _mm_storeu_pd(data, a); }
+  static Type Set(double value) { return _mm_set1_pd(value); }
+  static Type SetBits(uint64_t bits) { return _mm_castsi128_pd(_mm_set1_epi64x((long long)bits)); }
+  static Type Add(Type a, Type b) { return _mm_add_pd(a, b); }
+  static Type Sub(Type a, Type b) { return _mm_sub_pd(a, b); }
+  static Type Mul(Type a, Type b) { return _mm_mul_pd(a, b); }
+  static Type Div(Type a, Type b) { return _mm_div_pd(a, b); }
+  static Type Max(Type a, Type b) { return _mm_max_pd(a, b); }
+  static Type MulAdd(Type a, Type b, Type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+  static Type TwoProd(Type a, Type b, Type& error) {
+    Type splitter = Set(134217729.0);   //2^27 + 1
+    Type product = Mul(a, b);
+    Type ca = Mul(splitter, a), cb = Mul(splitter, b);
+    Type aHi = Sub(ca, Sub(ca, a)), bHi = Sub(cb, Sub(cb, b));
+    Type aLo = Sub(a, aHi), bLo = Sub(b, bHi);
+    error = Add(Add(Add(Sub(Mul(aHi, bHi), product), Mul(aHi, bLo)), Mul(aLo, bHi)), Mul(aLo, bLo));
+    return product;
+  }
+  static Type And(Type a, Type b) { return _mm_and_pd(a, b); }
+  static Type Or(Type a, Type b) { return _mm_or_pd(a, b); }
+  static Type Xor(Type a, Type b) { return _mm_xor_pd(a, b); }
+  static Type AddInt(Type a, Type b) { return _mm_castsi128_pd(_mm_add_epi64(_mm_castpd_si128(a), _mm_castpd_si128(b))); }
+  static Type SubInt(Type a, Type b) { return _mm_castsi128_pd(_mm_sub_epi64(_mm_castpd_si128(a), _mm_castpd_si128(b))); }
+  static Type ShiftLeft(Type a, int count) { return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(a), count)); }
+  static Type ShiftRight(Type a, int count) { return _mm_castsi128_pd(_mm_srli_epi64(_mm_castpd_si128(a), count)); }
+  static Mask Less(Type a, Type b) { return _mm_cmplt_pd(a, b); }
+  static Mask LessEqual(Type a, Type b) { return _mm_cmple_pd(a, b); }
+  static Mask GreaterEqual(Type a, Type b) { return _mm_cmpge_pd(a, b); }
+  static Type Blend(Mask mask, Type a, Type b) { return _mm_or_pd(_mm_and_pd(mask, b), _mm_andnot_pd(mask, a)); }
+  static unsigned MaskBits(Mask mask) { return (unsigned)_mm_movemask_pd(mask); }
+};
+
+const VectorKernels* GetSse2Kernels(void) {
+  static const VectorKernels kernels = LaneMath<Sse2Lane>::MakeKernels(VectorIsa::SSE2, "sse2");
+  return &kernels;
+}
+#else
+const VectorKernels* GetSse2Kernels(void) {
+  return nullptr;
+}
+#endif
\ No newline at end of file
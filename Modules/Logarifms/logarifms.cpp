@@ -1,26 +1,52 @@
 #include "logarifms.h"
+#include "../../Calculator/VectorMath/VectorMath.h"
+#include <algorithm>
 
-std::shared_ptr<Literal> Ln(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(log(args[0]->GetValue()));
+double Ln(double a) {
+  return log(a);
 }
 
-std::shared_ptr<Literal> Exp(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(exp(args[0]->GetValue()));
+double Exp(double a) {
+  return exp(a);
 }
 
-std::shared_ptr<Literal> Log(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(log(args[1]->GetValue()) / log(args[0]->GetValue()));
+double Log(double a, double b) {
+  return log(b) / log(a);
 }
 
-std::shared_ptr<Literal> GetExp(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(E);
+double GetExp(const double*, size_t) {
+  return E;
 }
 
-extern "C" __declspec(dllexport) void __cdecl Load(OperationsDescription & dstr) {
-  std::vector<Function> functions = { { "ln", 1, Ln },
-                                      { "exp", 1, Exp },
-                                      { "log", 2, Log },
-                                      {"getExp", 0, GetExp} };
-  for (auto func : functions)
-    dstr.LoadOperation(std::make_shared<Function>(func));
+void LnBatch(const double* const* args, double* out, size_t n) {
+  GetVectorKernels().log(args[0], out, n);
+}
+
+void ExpBatch(const double* const* args, double* out, size_t n) {
+  GetVectorKernels().exp(args[0], out, n);
+}
+
+void LogBatch(const double* const* args, double* out, size_t n) {
+  const VectorKernels& kernels = GetVectorKernels();
+  constexpr size_t CHUNK_SIZE = 256;
+  double base[CHUNK_SIZE];
+  for (size_t first = 0; first < n; first += CHUNK_SIZE) {
+    size_t count = std::min(CHUNK_SIZE, n - first);
+    //logarithm of base is taken first, since out may be equal to it
+    kernels.log(args[0] + first, base, count);
+    kernels.log(args[1] + first, out + first, count);
+    kernels.div(out + first, base, out + first, count);
+  }
+}
+
+MODULE_EXPORT void MODULE_CALL Load(OperationsDescription & dstr) {
+  std::vector<std::pair<Function, Operation::BatchKernel>> functions = { { { "ln", Ln }, LnBatch },
+                                                                        { { "exp", Exp }, ExpBatch },
+                                                                        { { "log", Log }, LogBatch },
+                                                                        { {"getExp", 0, GetExp}, nullptr } };
+  for (auto& [func, kernel] : functions) {
+    auto function = std::make_shared<Function>(func);
+    function->SetBatchOperation(kernel);
+    dstr.LoadOperation(function);
+  }
 }
\ No newline at end of file
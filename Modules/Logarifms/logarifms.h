@@ -1,13 +1,17 @@
 #pragma once
 
-#include "..\..\Calculator\API\API.h"
+#include "../../Calculator/API/API.h"
 #include <cmath>
 
-extern "C" __declspec(dllexport) void __cdecl Load(OperationsDescription & dstr);
+MODULE_EXPORT void MODULE_CALL Load(OperationsDescription & dstr);
 
 constexpr double E = 2.7182818284590452;
 
-std::shared_ptr<Literal> Ln(std::vector<std::shared_ptr<Operand>> args);
-std::shared_ptr<Literal> Exp(std::vector<std::shared_ptr<Operand>> args);
-std::shared_ptr<Literal> Log(std::vector<std::shared_ptr<Operand>> args);
-std::shared_ptr<Literal> GetExp(std::vector<std::shared_ptr<Operand>> args);
\ No newline at end of file
+double Ln(double a);
+double Exp(double a);
+double Log(double a, double b);
+double GetExp(const double* args, size_t argsNum);
+
+void LnBatch(const double* const* args, double* out, size_t n);
+void ExpBatch(const double* const* args, double* out, size_t n);
+void LogBatch(const double* const* args, double* out, size_t n);
\ No newline at end of file
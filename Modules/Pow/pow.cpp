@@ -1,13 +1,20 @@
 #include "pow.h"
+#include "../../Calculator/VectorMath/VectorMath.h"
 #include <cmath>
 
-std::shared_ptr<Literal> Pow(std::shared_ptr<Operand> a, std::shared_ptr<Operand> b) {
-  return std::make_shared<Literal>(pow(a->GetValue(), b->GetValue()));
+double Pow(const Value& a, const Value& b) {
+  return pow(a.GetValue(), b.GetValue());
 }
 
-extern "C" __declspec(dllexport) void __cdecl Load(OperationsDescription & dstr) {
+void PowBatch(const double* const* args, double* out, size_t n) {
+  GetVectorKernels().pow(args[0], args[1], out, n);
+}
+
+MODULE_EXPORT void MODULE_CALL Load(OperationsDescription & dstr) {
   //OperationsDescription& dstr = OperationsDescription::GetInstance();
   const BinaryOperator pow = { "^", 4, Pow, BinaryOperator::Associative::RIGHT};
 
-  dstr.LoadOperation(std::make_shared<BinaryOperator>(pow));
+  auto operation = std::make_shared<BinaryOperator>(pow);
+  operation->SetBatchOperation(PowBatch);
+  dstr.LoadOperation(operation);
 }
\ No newline at end of file
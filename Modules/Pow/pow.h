@@ -1,7 +1,9 @@
 #pragma once
 
-#include "..\..\Calculator\API\API.h"
+#include "../../Calculator/API/API.h"
 
-extern "C" __declspec(dllexport) void __cdecl Load(OperationsDescription & dstr);
+MODULE_EXPORT void MODULE_CALL Load(OperationsDescription & dstr);
 
-std::shared_ptr<Literal> Pow(std::shared_ptr<Operand> a, std::shared_ptr<Operand> b);
\ No newline at end of file
+double Pow(const Value& a, const Value& b);
+
+void PowBatch(const double* const* args, double* out, size_t n);
\ No newline at end of file
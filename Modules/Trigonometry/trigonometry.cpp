@@ -1,50 +1,92 @@
 #include "trigonometry.h"
+#include "../../Calculator/VectorMath/VectorMath.h"
 
-std::shared_ptr<Literal> Sin(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(sin(args[0]->GetValue()));
+double Sin(double a) {
+  return sin(a);
 }
 
-std::shared_ptr<Literal> Cos(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(cos(args[0]->GetValue()));
+double Cos(double a) {
+  return cos(a);
 }
 
-std::shared_ptr<Literal> Tan(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(tan(args[0]->GetValue()));
+double Tan(double a) {
+  return tan(a);
 }
 
-std::shared_ptr<Literal> Cot(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(1 / tan(args[0]->GetValue()));
+double Cot(double a) {
+  return 1 / tan(a);
 }
 
-std::shared_ptr<Literal> Arcsin(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(asin(args[0]->GetValue()));
+double Arcsin(double a) {
+  return asin(a);
 }
 
-std::shared_ptr<Literal> Arccos(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(acos(args[0]->GetValue()));
+double Arccos(double a) {
+  return acos(a);
 }
 
-std::shared_ptr<Literal> Arctan(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(atan(args[0]->GetValue()));
+double Arctan(double a) {
+  return atan(a);
 }
-std::shared_ptr<Literal> Arccot(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(atan(-args[0]->GetValue()) + Pi/2);
+double Arccot(double a) {
+  return atan(-a) + Pi/2;
 }
 
-std::shared_ptr<Literal> GetPi(std::vector<std::shared_ptr<Operand>> args) {
-  return std::make_shared<Literal>(Pi);
+double GetPi(const double*, size_t) {
+  return Pi;
 }
 
-extern "C" __declspec(dllexport) void __cdecl Load(OperationsDescription & dstr) {
-  std::vector<Function> functions = { { "sin", 1, Sin },
-                                      { "cos", 1, Cos },
-                                      { "tan", 1, Tan },
-                                      { "cot", 1, Cot },
-                                      { "arcsin", 1, Arcsin},
-                                      { "arccos", 1, Arccos },
-                                      { "arctan", 1, Arctan },
-                                      { "arccot", 1, Arccot },
-                                      { "getPi", 0, GetPi } };
-  for (auto func : functions)
-    dstr.LoadOperation(std::make_shared<Function>(func));
+void SinBatch(const double* const* args, double* out, size_t n) {
+  GetVectorKernels().sin(args[0], out, n);
+}
+
+void CosBatch(const double* const* args, double* out, size_t n) {
+  GetVectorKernels().cos(args[0], out, n);
+}
+
+void TanBatch(const double* const* args, double* out, size_t n) {
+  GetVectorKernels().tan(args[0], out, n);
+}
+
+void CotBatch(const double* const* args, double* out, size_t n) {
+  GetVectorKernels().tan(args[0], out, n);
+  for (size_t i = 0; i < n; ++i)
+    out[i] = 1 / out[i];
+}
+
+void ArcsinBatch(const double* const* args, double* out, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = asin(args[0][i]);
+}
+
+void ArccosBatch(const double* const* args, double* out, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = acos(args[0][i]);
+}
+
+void ArctanBatch(const double* const* args, double* out, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = atan(args[0][i]);
+}
+
+void ArccotBatch(const double* const* args, double* out, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = atan(-args[0][i]) + Pi / 2;
+}
+
+MODULE_EXPORT void MODULE_CALL Load(OperationsDescription & dstr) {
+  std::vector<std::pair<Function, Operation::BatchKernel>> functions = { { { "sin", Sin }, SinBatch },
+                                                                        { { "cos", Cos }, CosBatch },
+                                                                        { { "tan", Tan }, TanBatch },
+                                                                        { { "cot", Cot }, CotBatch },
+                                                                        { { "arcsin", Arcsin }, ArcsinBatch },
+                                                                        { { "arccos", Arccos }, ArccosBatch },
+                                                                        { { "arctan", Arctan }, ArctanBatch },
+                                                                        { { "arccot", Arccot }, ArccotBatch },
+                                                                        { { "getPi", 0, GetPi }, nullptr } };
+  for (auto& [func, kernel] : functions) {
+    auto function = std::make_shared<Function>(func);
+    function->SetBatchOperation(kernel);
+    dstr.LoadOperation(function);
+  }
 }
\ No newline at end of file
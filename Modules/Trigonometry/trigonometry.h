@@ -1,20 +1,30 @@
 #pragma once
 
-#include "..\..\Calculator\API\API.h"
+#include "../../Calculator/API/API.h"
 #include <cmath>
 
-extern "C" __declspec(dllexport) void __cdecl Load(OperationsDescription & dstr);
+MODULE_EXPORT void MODULE_CALL Load(OperationsDescription & dstr);
 
 constexpr double Pi = 3.1415926535897932;
 
-std::shared_ptr<Literal> Sin(std::vector<std::shared_ptr<Operand>> args);
-std::shared_ptr<Literal> Cos(std::vector<std::shared_ptr<Operand>> args);
-std::shared_ptr<Literal> Tan(std::vector<std::shared_ptr<Operand>> args);
-std::shared_ptr<Literal> Cot(std::vector<std::shared_ptr<Operand>> args);
+double Sin(double a);
+double Cos(double a);
+double Tan(double a);
+double Cot(double a);
 
-std::shared_ptr<Literal> Arcsin(std::vector<std::shared_ptr<Operand>> args);
-std::shared_ptr<Literal> Arccos(std::vector<std::shared_ptr<Operand>> args);
-std::shared_ptr<Literal> Arctan(std::vector<std::shared_ptr<Operand>> args);
-std::shared_ptr<Literal> Arccot(std::vector<std::shared_ptr<Operand>> args);
+double Arcsin(double a);
+double Arccos(double a);
+double Arctan(double a);
+double Arccot(double a);
 
-std::shared_ptr<Literal> GetPi(std::vector<std::shared_ptr<Operand>> args);
\ No newline at end of file
+double GetPi(const double* args, size_t argsNum);
+
+void SinBatch(const double* const* args, double* out, size_t n);
+void CosBatch(const double* const* args, double* out, size_t n);
+void TanBatch(const double* const* args, double* out, size_t n);
+void CotBatch(const double* const* args, double* out, size_t n);
+
+void ArcsinBatch(const double* const* args, double* out, size_t n);
+void ArccosBatch(const double* const* args, double* out, size_t n);
+void ArctanBatch(const double* const* args, double* out, size_t n);
+void ArccotBatch(const double* const* args, double* out, size_t n);
\ No newline at end of file
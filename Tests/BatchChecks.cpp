@@ -0,0 +1,234 @@
+#include "../Calculator/BaseOperations/BaseOperation.h"
+#include "../Calculator/Interpreter/Interpreter.h"
+#include "../Calculator/VectorMath/VectorMath.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+/**
+* @brief number of rows of checked columns, it is not a multiple of BATCH_SIZE
+*/
+constexpr size_t CHECK_ROWS = 3 * BATCH_SIZE + 17;
+
+/**
+* @brief function of check that two results are the same
+* @param[in] a - the first result
+* @param[in] b - the second result
+* @return true if results have the same bits or both are NaN, false otherwise
+*/
+bool IsSame(double a, double b) {
+  return std::memcmp(&a, &b, sizeof(double)) == 0 || (std::isnan(a) && std::isnan(b));
+}
+
+/**
+* @brief function of check that batch result is close to scalar one
+* @param[in] result - result of batch evaluation
+* @param[in] expected - result of scalar evaluation
+* @param[in] tolerance - allowed error in units in the last place of expected result
+* @return true if results are the same or both are finite and differ by less than tolerance, false otherwise
+*/
+bool IsClose(double result, double expected, double tolerance) {
+  if (IsSame(result, expected))
+    return true;
+  if (!std::isfinite(result) || !std::isfinite(expected) || expected == 0)
+    return false;
+  return std::fabs(result - expected) < tolerance * std::ldexp(1.0, std::ilogb(expected) - 52);
+}
+
+/**
+* @brief function of value of variable in row of check
+* @param[in] slot - slot of variable
+* @param[in] row - number of row
+* @return value, there are negative zeros among values
+*/
+double RowValue(size_t slot, size_t row) {
+  return (row % 2 == 0 ? 1 : -1) * (0.25 * row + slot) + (row % 7 == 0 ? -0.0 : 0.0);
+}
+
+/**
+* @brief function of value of variable in row of check at edges of domains of vector math kernels
+* @param[in] slot - slot of variable
+* @param[in] row - number of row
+* @return value, values out of ranges of polynomial approximations are mixed with ones inside in every block
+*/
+double EdgeValue(size_t slot, size_t row) {
+  static const double values[] = {
+    1, 0.5, 2, 3, -1, 1e7, -3e8, 1e300, 1000, -1000, 708.5, -745.2, 710, -0.0, 0.0, 1e-310, -1e-310,
+    INFINITY, -INFINITY, NAN, -2.5, 1e6, 1.1e6, 1e-300, 0.75, -7, 123.456, 1e20, -0.5, 4, 1e-20, 89, -13,
+  };
+  constexpr size_t valuesNum = sizeof(values) / sizeof(values[0]);
+  return values[(row + 5 * slot) % valuesNum];
+}
+
+/**
+* @brief function of check that EvaluateBatch gives the same results as Evaluate row by row
+* @param[in] expression - expression in string form
+* @param[in] missing - name of variable which has no column or empty string
+* @param[in] value - function of value of variable in row
+* @param[in] tolerance - allowed error of polynomial approximations in units in the last place, 0 if results must be the same
+* @return true if results are the same, false otherwise
+*/
+bool CheckBatch(const std::string& expression, const std::string& missing = "", double (*value)(size_t, size_t) = RowValue,
+                double tolerance = 0) {
+  CompiledExpression program = Compile(expression);
+  size_t variablesCount = program.GetVariablesCount();
+  std::vector<std::vector<double>> data(variablesCount, std::vector<double>(CHECK_ROWS));
+  std::vector<const double*> columns(variablesCount);
+  for (size_t slot = 0; slot < variablesCount; ++slot) {
+    for (size_t row = 0; row < CHECK_ROWS; ++row)
+      data[slot][row] = value(slot, row);
+    columns[slot] = program.GetVariableName(slot) == missing ? nullptr : data[slot].data();
+  }
+
+  std::vector<double> expected(CHECK_ROWS);
+  bool expectedThrow = false;
+  try {
+    for (size_t row = 0; row < CHECK_ROWS; ++row) {
+      VariableBinding binding(program);
+      for (size_t slot = 0; slot < variablesCount; ++slot)
+        if (columns[slot] != nullptr)
+          binding.SetValue(slot, columns[slot][row]);
+      expected[row] = Evaluate(program, binding);
+    }
+  }
+  catch (const std::exception&) {
+    expectedThrow = true;
+  }
+
+  ThreadPool pool(3);
+  for (ThreadPool* usedPool : { static_cast<ThreadPool*>(nullptr), &pool }) {
+    std::vector<double> out(CHECK_ROWS);
+    bool thrown = false;
+    try {
+      if (usedPool == nullptr)
+        EvaluateBatch(program, columns.data(), CHECK_ROWS, out.data());
+      else
+        EvaluateBatch(program, columns.data(), CHECK_ROWS, out.data(), *usedPool);
+    }
+    catch (const std::exception&) {
+      thrown = true;
+    }
+    if (thrown != expectedThrow) {
+      std::cout << "FAIL " << expression << ": batch " << (thrown ? "throws" : "does not throw") << std::endl;
+      return false;
+    }
+    for (size_t row = 0; !thrown && row < CHECK_ROWS; ++row)
+      if (!IsClose(out[row], expected[row], tolerance)) {
+        std::cout << "FAIL " << expression << ": row " << row << " batch " << out[row] << " scalar " << expected[row] << std::endl;
+        return false;
+      }
+  }
+  return true;
+}
+
+/**
+* @brief logarithm of scalar evaluation
+*/
+double Ln(double a) {
+  return std::log(a);
+}
+
+/**
+* @brief exponent of scalar evaluation
+*/
+double Exp(double a) {
+  return std::exp(a);
+}
+
+/**
+* @brief sine of scalar evaluation
+*/
+double Sin(double a) {
+  return std::sin(a);
+}
+
+/**
+* @brief cosine of scalar evaluation
+*/
+double Cos(double a) {
+  return std::cos(a);
+}
+
+/**
+* @brief tangent of scalar evaluation
+*/
+double Tan(double a) {
+  return std::tan(a);
+}
+
+/**
+* @brief power of scalar evaluation
+*/
+double Pow(double a, double b) {
+  return std::pow(a, b);
+}
+
+/**
+* @brief function of loading functions whose batch kernels are vector math kernels like ones of modules
+* @param[in/out] dstr - description of operations
+*/
+void LoadVectorFunctions(OperationsDescription& dstr) {
+  std::vector<std::pair<Function, Operation::BatchKernel>> functions = {
+    { { "ln", Ln }, [](const double* const* args, double* out, size_t n) { GetVectorKernels().log(args[0], out, n); } },
+    { { "exp", Exp }, [](const double* const* args, double* out, size_t n) { GetVectorKernels().exp(args[0], out, n); } },
+    { { "sin", Sin }, [](const double* const* args, double* out, size_t n) { GetVectorKernels().sin(args[0], out, n); } },
+    { { "cos", Cos }, [](const double* const* args, double* out, size_t n) { GetVectorKernels().cos(args[0], out, n); } },
+    { { "tan", Tan }, [](const double* const* args, double* out, size_t n) { GetVectorKernels().tan(args[0], out, n); } },
+    { { "pow", Pow }, [](const double* const* args, double* out, size_t n) { GetVectorKernels().pow(args[0], args[1], out, n); } },
+  };
+  for (auto& [func, kernel] : functions) {
+    auto function = std::make_shared<Function>(func);
+    function->SetBatchOperation(kernel);
+    dstr.LoadOperation(function);
+  }
+}
+
+int main(void) {
+  OperationsDescription& dstr = OperationsDescription::GetInstance();
+  LoadBase(dstr);
+  LoadVectorFunctions(dstr);
+
+  const std::vector<std::string> expressions = {
+    "x + y * 2 - x / (y + 3)",
+    "-x + max(x, y)",
+    "x*1 + (x = 5)",
+    "x + (x = 2)",
+    "x*1 + x++ + x",
+    "x-0 - --x * 2",
+    "max(x*1, x = 3) + x",
+    "(x = x * 2) + x*1 + y",
+    "x*1 + (x = y) + (y = 4) + y*1",
+    "x++ + x-- + x*1",
+    "x + 0",
+    "0 - x",
+  };
+  size_t failsNum = 0;
+  for (auto& expression : expressions)
+    failsNum += !CheckBatch(expression);
+  failsNum += !CheckBatch("(y = x * 2) + y", "y");
+  failsNum += !CheckBatch("y + x", "y");
+
+  //bounds of VectorMath.h and 1 ulp of the C library, results of lanes passed to the C library must be the same
+  const std::vector<std::pair<std::string, double>> vectorExpressions = {
+    { "ln(x-2)", 2 },
+    { "ln(x*y)", 2 },
+    { "exp(x*1000)", 2 },
+    { "exp(y*0.5)", 2 },
+    { "sin(x*1e7)", 3 },
+    { "sin(x)", 3 },
+    { "cos(-y)", 3 },
+    { "tan(x*3)", 4.5 },
+    { "pow(x, y)", 3.5 },
+    { "pow(x-2, y*3)", 3.5 },
+  };
+  for (auto& [expression, tolerance] : vectorExpressions)
+    failsNum += !CheckBatch(expression, "", EdgeValue, tolerance);
+
+  dstr.Clear();
+  if (failsNum != 0) {
+    std::cout << failsNum << " batch checks failed" << std::endl;
+    return 1;
+  }
+  std::cout << "Batch checks passed" << std::endl;
+  return 0;
+}
\ No newline at end of file
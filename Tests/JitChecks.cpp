@@ -0,0 +1,164 @@
+#include "../Calculator/BaseOperations/BaseOperation.h"
+#include "../Calculator/Calc/Calculator.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+/**
+* @brief number of sets of variables every expression is checked with
+*/
+constexpr size_t CHECK_ROWS = 257;
+
+/**
+* @brief function of check that two results are the same
+* @param[in] a - the first result
+* @param[in] b - the second result
+* @return true if results have the same bits or both are NaN, false otherwise
+*/
+bool IsSame(double a, double b) {
+  return std::memcmp(&a, &b, sizeof(double)) == 0 || (std::isnan(a) && std::isnan(b));
+}
+
+/**
+* @brief function of one argument which is called by machine code through a pointer
+*/
+double Half(double a) {
+  return a / 2;
+}
+
+/**
+* @brief function of two arguments which is called by machine code through a pointer
+*/
+double Hypot(double a, double b) {
+  return std::sqrt(a * a + b * b);
+}
+
+/**
+* @brief function of any number of arguments which is called by machine code through a pointer
+*/
+double Sum(const double* args, size_t argsNum) {
+  double sum = 0;
+  for (size_t i = 0; i < argsNum; ++i)
+    sum += args[i];
+  return sum;
+}
+
+/**
+* @brief function of value of variable in row of check
+* @param[in] slot - slot of variable
+* @param[in] row - number of row
+* @return value, there are negative zeros, infinities and NaN among values
+*/
+double RowValue(size_t slot, size_t row) {
+  switch (row % 11) {
+  case 0:
+    return -0.0;
+  case 5:
+    return slot % 2 == 0 ? INFINITY : -INFINITY;
+  case 7:
+    return NAN;
+  default:
+    return (row % 2 == 0 ? 1 : -1) * (0.37 * row + slot);
+  }
+}
+
+/**
+* @brief function of check that machine code gives the same results as interpreter
+* @param[in] expression - expression in string form
+* @param[in] native - true if expression must be translated into machine code on this platform
+* @return true if results are the same, false otherwise
+*/
+bool CheckNative(const std::string& expression, bool native) {
+  CompiledExpression program = Compile(expression);
+  TieredExpression tiered(program);
+  if (tiered.Promote() != native) {
+    std::cout << "FAIL " << expression << ": expression is " << (native ? "not " : "") << "native" << std::endl;
+    return false;
+  }
+
+  for (size_t row = 0; row < CHECK_ROWS; ++row) {
+    VariableBinding interpreted(program);
+    VariableBinding jitted(program);
+    for (size_t slot = 0; slot < program.GetVariablesCount(); ++slot) {
+      interpreted.SetValue(slot, RowValue(slot, row));
+      jitted.SetValue(slot, RowValue(slot, row));
+    }
+    double expected = Evaluate(program, interpreted);
+    double result = tiered.Evaluate(jitted);
+    if (!IsSame(result, expected)) {
+      std::cout << "FAIL " << expression << ": row " << row << " native " << result << " interpreter " << expected << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+* @brief function of check that expression calculated through cache becomes native after JIT_THRESHOLD evaluations
+* @param[in] expression - expression in string form with variable x
+* @param[in] native - true if expression must be translated into machine code on this platform
+* @return true if results agree with interpreter and expression is promoted, false otherwise
+*/
+bool CheckPromotion(const std::string& expression, bool native) {
+  EvaluationContext context;
+  EvaluationContext reference;
+  CompiledExpression program = Compile(expression);
+  for (size_t row = 0; row < 2 * JIT_THRESHOLD; ++row) {
+    Variable x("x");
+    x.SetValue(RowValue(0, row));
+    context.AddVariable(x);
+    reference.AddVariable(x);
+    double result = context.Calculate(expression);
+    double expected = reference.Evaluate(program);
+    if (!IsSame(result, expected)) {
+      std::cout << "FAIL " << expression << ": evaluation " << row << " cached " << result << " interpreter " << expected << std::endl;
+      return false;
+    }
+  }
+  if (CompileCache::GetInstance().Compile(expression)->IsNative() != native) {
+    std::cout << "FAIL " << expression << ": cached expression is " << (native ? "not " : "") << "promoted" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+int main(void) {
+  OperationsDescription& dstr = OperationsDescription::GetInstance();
+  LoadBase(dstr);
+  auto staging = OperationsDescription::CreateStaging();
+  staging->LoadOperation(std::make_shared<Function>(Function("half", Half)));
+  staging->LoadOperation(std::make_shared<Function>(Function("hypot", Hypot)));
+  staging->LoadOperation(std::make_shared<Function>(Function("sum", 3, Sum)));
+  dstr.Merge({ staging.get() });
+
+#if defined(__x86_64__) || defined(_M_X64)
+  const bool jit = true;
+#else
+  const bool jit = false;
+#endif
+  const std::vector<std::string> expressions = {
+    "x + y * 2 - x / (y + 3)",
+    "-x + max(x, y)",
+    "max(x - y, -0) / (x * y)",
+    "half(x) + hypot(x, y) * 0.5",
+    "sum(x, y, half(x)) - sum(1, 2, 3)",
+    "(x + y) * (x - y) / (x + 1) - -y",
+    "42",
+  };
+  size_t failsNum = 0;
+  for (auto& expression : expressions)
+    failsNum += !CheckNative(expression, jit);
+  failsNum += !CheckNative("x + (x = 2)", false);
+  failsNum += !CheckNative("x++ + x", false);
+  failsNum += !CheckPromotion("x * 3 - half(x)", jit);
+  failsNum += !CheckPromotion("(x = x * 2) + x", false);
+
+  CompileCache::GetInstance().Clear();
+  dstr.Clear();
+  if (failsNum != 0) {
+    std::cout << failsNum << " JIT checks failed" << std::endl;
+    return 1;
+  }
+  std::cout << "JIT checks passed" << std::endl;
+  return 0;
+}
\ No newline at end of file
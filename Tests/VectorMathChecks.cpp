@@ -0,0 +1,210 @@
+#include "../Calculator/VectorMath/VectorMath.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+* @brief arguments which kernels pass to the C library, they are mixed with ones computed by polynomials
+*/
+const std::vector<double> EDGE_ARGUMENTS = {
+  1e7, -3e8, 1e300, 1000, -1000, 708.5, -745.2, 710, -1, -0.0, 0.0, 1e-310, -1e-310,
+  INFINITY, -INFINITY, NAN, 0.5, 2, -2.5, 3, 1e6, 1.1e6, 1e-300, 0.75, -7, 123.456, 1e20, -0.5, 4, 1e-20, 89, -13,
+};
+
+/**
+* @brief function of check that two results are the same
+* @param[in] a - the first result
+* @param[in] b - the second result
+* @return true if results have the same bits or both are NaN, false otherwise
+*/
+bool IsSame(double a, double b) {
+  return std::memcmp(&a, &b, sizeof(double)) == 0 || (std::isnan(a) && std::isnan(b));
+}
+
+/**
+* @brief function of check that results of kernel do not depend on whether out is equal to an argument
+* @param[in] kernels - kernels of instruction set
+* @param[in] name - name of kernel
+* @param[in] expected - results computed to separate array
+* @param[in] result - results computed in place
+* @return true if results are the same, false otherwise
+*/
+bool CheckSame(const VectorKernels& kernels, const std::string& name, const std::vector<double>& expected, const std::vector<double>& result) {
+  for (size_t i = 0; i < expected.size(); ++i)
+    if (!IsSame(expected[i], result[i])) {
+      std::cout << "FAIL " << kernels.name << " " << name << " in place: element " << i << " is " << result[i] << " instead of " << expected[i] << std::endl;
+      return false;
+    }
+  return true;
+}
+
+/**
+* @brief function of check of kernel of one argument called in place
+* @param[in] kernels - kernels of instruction set
+* @param[in] name - name of kernel
+* @param[in] kernel - kernel
+* @return true if kernel gives the same results in place, false otherwise
+*/
+bool CheckUnaryInPlace(const VectorKernels& kernels, const std::string& name, VectorKernels::UnaryKernel kernel) {
+  const std::vector<double>& a = EDGE_ARGUMENTS;
+  std::vector<double> expected(a.size());
+  kernel(a.data(), expected.data(), a.size());
+  std::vector<double> result = a;
+  kernel(result.data(), result.data(), result.size());
+  return CheckSame(kernels, name, expected, result);
+}
+
+/**
+* @brief function of check of kernel of two arguments called in place of either argument
+* @param[in] kernels - kernels of instruction set
+* @param[in] name - name of kernel
+* @param[in] kernel - kernel
+* @return true if kernel gives the same results in place, false otherwise
+*/
+bool CheckBinaryInPlace(const VectorKernels& kernels, const std::string& name, VectorKernels::BinaryKernel kernel) {
+  const std::vector<double>& a = EDGE_ARGUMENTS;
+  std::vector<double> b(a.rbegin(), a.rend());
+  std::vector<double> expected(a.size());
+  kernel(a.data(), b.data(), expected.data(), a.size());
+  std::vector<double> first = a;
+  kernel(first.data(), b.data(), first.data(), first.size());
+  std::vector<double> second = b;
+  kernel(a.data(), second.data(), second.data(), second.size());
+  return CheckSame(kernels, name + " (out is a)", expected, first) && CheckSame(kernels, name + " (out is b)", expected, second);
+}
+
+/**
+* @brief number of random arguments every kernel is checked with for accuracy
+*/
+constexpr size_t ACCURACY_ARGUMENTS = 1 << 16;
+
+/**
+* @brief function of error of result in units in the last place
+* @param[in] result - result of kernel
+* @param[in] reference - result in extended precision
+* @return error in units in the last place of rounded reference
+*/
+double Ulp(double result, long double reference) {
+  long double ulp = std::ldexp(1.0L, std::ilogb(static_cast<double>(reference)) - std::numeric_limits<double>::digits + 1);
+  return static_cast<double>(std::fabs(result - reference) / ulp);
+}
+
+/**
+* @brief function of check that error of kernel does not exceed documented bound
+* @param[in] kernels - kernels of instruction set
+* @param[in] name - name of kernel
+* @param[in] result - results of kernel
+* @param[in] reference - results in extended precision
+* @param[in] bound - documented bound in units in the last place
+* @return true if every error is below bound, false otherwise
+*/
+bool CheckUlp(const VectorKernels& kernels, const std::string& name, const std::vector<double>& result,
+              const std::vector<long double>& reference, double bound) {
+  double maxError = 0;
+  for (size_t i = 0; i < result.size(); ++i)
+    if (std::isfinite(static_cast<double>(reference[i])) && reference[i] != 0)
+      maxError = std::max(maxError, Ulp(result[i], reference[i]));
+  if (maxError >= bound) {
+    std::cout << "FAIL " << kernels.name << " " << name << ": error " << maxError << " ulp is not below " << bound << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+* @brief function of check of accuracy of kernel of one argument
+* @param[in] kernels - kernels of instruction set
+* @param[in] name - name of kernel
+* @param[in] kernel - kernel
+* @param[in] reference - function in extended precision
+* @param[in] argument - generator of arguments
+* @param[in] bound - documented bound in units in the last place
+* @return true if every error is below bound, false otherwise
+*/
+template<typename Generator>
+bool CheckUnaryUlp(const VectorKernels& kernels, const std::string& name, VectorKernels::UnaryKernel kernel,
+                   long double (*reference)(long double), Generator argument, double bound) {
+  std::mt19937_64 random(ACCURACY_ARGUMENTS);
+  std::vector<double> a(ACCURACY_ARGUMENTS);
+  std::vector<long double> expected(a.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = argument(random);
+    expected[i] = reference(a[i]);
+  }
+  std::vector<double> result(a.size());
+  kernel(a.data(), result.data(), a.size());
+  return CheckUlp(kernels, name, result, expected, bound);
+}
+
+/**
+* @brief function of check of accuracy of pow while |b*ln(a)| <= 32
+* @param[in] kernels - kernels of instruction set
+* @return true if every error is below 2.5 ulp, false otherwise
+*/
+bool CheckPowUlp(const VectorKernels& kernels) {
+  std::mt19937_64 random(ACCURACY_ARGUMENTS);
+  std::uniform_real_distribution<double> unit(-1, 1);
+  std::vector<double> a(ACCURACY_ARGUMENTS);
+  std::vector<double> b(a.size());
+  std::vector<long double> expected(a.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    double ln = 700 * unit(random) * std::pow(10.0, 4 * unit(random) - 4);
+    a[i] = std::exp(ln);
+    b[i] = ln != 0 ? 32 * unit(random) / ln : 1;
+    expected[i] = std::pow(static_cast<long double>(a[i]), static_cast<long double>(b[i]));
+  }
+  std::vector<double> result(a.size());
+  kernels.pow(a.data(), b.data(), result.data(), a.size());
+  return CheckUlp(kernels, "pow", result, expected, 2.5);
+}
+
+int main(void) {
+  size_t failsNum = 0;
+  for (VectorIsa isa : { VectorIsa::SCALAR, VectorIsa::SSE2, VectorIsa::AVX2, VectorIsa::AVX512 }) {
+    const VectorKernels* kernels = GetVectorKernels(isa);
+    if (kernels == nullptr)
+      continue;
+    failsNum += !CheckBinaryInPlace(*kernels, "add", kernels->add);
+    failsNum += !CheckBinaryInPlace(*kernels, "sub", kernels->sub);
+    failsNum += !CheckBinaryInPlace(*kernels, "mul", kernels->mul);
+    failsNum += !CheckBinaryInPlace(*kernels, "div", kernels->div);
+    failsNum += !CheckBinaryInPlace(*kernels, "max", kernels->max);
+    failsNum += !CheckUnaryInPlace(*kernels, "neg", kernels->neg);
+    failsNum += !CheckUnaryInPlace(*kernels, "sin", kernels->sin);
+    failsNum += !CheckUnaryInPlace(*kernels, "cos", kernels->cos);
+    failsNum += !CheckUnaryInPlace(*kernels, "tan", kernels->tan);
+    failsNum += !CheckUnaryInPlace(*kernels, "exp", kernels->exp);
+    failsNum += !CheckUnaryInPlace(*kernels, "log", kernels->log);
+    failsNum += !CheckBinaryInPlace(*kernels, "pow", kernels->pow);
+
+    auto trigonometric = [](std::mt19937_64& random) {
+      std::uniform_real_distribution<double> unit(-1, 1);
+      return 1e6 * unit(random) * std::pow(10.0, 4.5 * unit(random) - 4.5);
+    };
+    auto exponent = [](std::mt19937_64& random) { return std::uniform_real_distribution<double>(-708, 708)(random); };
+    auto positive = [](std::mt19937_64& random) { return std::exp(std::uniform_real_distribution<double>(-708, 708)(random)); };
+    long double (*sinReference)(long double) = std::sin;
+    long double (*cosReference)(long double) = std::cos;
+    long double (*tanReference)(long double) = std::tan;
+    long double (*expReference)(long double) = std::exp;
+    long double (*logReference)(long double) = std::log;
+    failsNum += !CheckUnaryUlp(*kernels, "sin", kernels->sin, sinReference, trigonometric, 2);
+    failsNum += !CheckUnaryUlp(*kernels, "cos", kernels->cos, cosReference, trigonometric, 2);
+    failsNum += !CheckUnaryUlp(*kernels, "tan", kernels->tan, tanReference, trigonometric, 3.5);
+    failsNum += !CheckUnaryUlp(*kernels, "exp", kernels->exp, expReference, exponent, 1);
+    failsNum += !CheckUnaryUlp(*kernels, "log", kernels->log, logReference, positive, 1);
+    failsNum += !CheckPowUlp(*kernels);
+  }
+
+  if (failsNum != 0) {
+    std::cout << failsNum << " vector math checks failed" << std::endl;
+    return 1;
+  }
+  std::cout << "Vector math checks passed" << std::endl;
+  return 0;
+}
\ No newline at end of file